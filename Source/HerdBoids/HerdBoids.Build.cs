@@ -0,0 +1,15 @@
+using UnrealBuildTool;
+
+// Engine-independent boids math shared by the herd simulation. Depends on Core only,
+// so it builds and runs without a world, actors or the physics scene.
+public class HerdBoids : ModuleRules
+{
+	public HerdBoids(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] {
+			"Core"
+		});
+	}
+}
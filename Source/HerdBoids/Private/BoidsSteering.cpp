@@ -0,0 +1,119 @@
+// BoidsSteering.cpp
+#include "BoidsSteering.h"
+
+namespace BoidsSteering
+{
+    float ArriveSpeed(float Distance, const FArriveParams& Params)
+    {
+        if (Distance <= Params.StopDistance)
+            return 0.0f;
+
+        if (Distance < Params.SlowdownDistance)
+        {
+            // Gradual slowdown
+            const float SlowdownFactor = (Distance - Params.StopDistance) / (Params.SlowdownDistance - Params.StopDistance);
+            return Params.Speed * SlowdownFactor;
+        }
+
+        return Params.Speed;
+    }
+
+    FVector Arrive(const FVector& Location, const FVector& Velocity, const FVector& Target, const FArriveParams& Params)
+    {
+        FVector ToTarget = Target - Location;
+        ToTarget.Z = 0; // Keep on ground
+
+        const float Distance = ToTarget.Size();
+
+        // Stop if we're close enough
+        if (Distance <= Params.StopDistance)
+        {
+            // Apply braking force
+            return -Velocity * 2.0f;
+        }
+
+        if (Distance > 0)
+        {
+            return ToTarget / Distance * ArriveSpeed(Distance, Params) - Velocity;
+        }
+
+        return FVector::ZeroVector;
+    }
+
+    FVector Flee(const FVector& Location, const FVector& Velocity, const FVector& Threat, float Speed)
+    {
+        FVector Away = Location - Threat;
+        Away.Z = 0; // Keep on ground
+
+        if (Away.Normalize())
+        {
+            return Away * Speed - Velocity;
+        }
+
+        return FVector::ZeroVector;
+    }
+
+    FVector Steer(const FVector& Direction, const FVector& Velocity, float Speed)
+    {
+        return Direction * Speed - Velocity;
+    }
+
+    FVector Separation(const CowHerdKernels::FSeparationSum& Sum, const FVector& Velocity, float MaxSpeed)
+    {
+        if (Sum.Count == 0)
+            return FVector::ZeroVector;
+
+        FVector Force = FVector(Sum.Force) / Sum.Count;
+        Force.Normalize();
+        return Force * MaxSpeed - Velocity;
+    }
+
+    FVector Alignment(const FVector& AverageVelocity, const FVector& Velocity, float MaxSpeed)
+    {
+        const FVector Heading = AverageVelocity.GetSafeNormal2D();
+        if (Heading.IsZero())
+            return FVector::ZeroVector;
+
+        return Heading * MaxSpeed - Velocity;
+    }
+
+    FVector Cohesion(const FVector& Location, const FVector& Velocity, const FVector& Centroid, float MaxSpeed)
+    {
+        const FVector ToCentroid = (Centroid - Location).GetSafeNormal2D();
+        if (ToCentroid.IsZero())
+            return FVector::ZeroVector;
+
+        return ToCentroid * MaxSpeed - Velocity;
+    }
+
+    FVector Wander(FVector& InOutTarget, FRandomStream& Stream, const FQuat& Facing, const FVector& Velocity, const FWanderParams& Params)
+    {
+        // Add random jitter to wander target
+        InOutTarget += FVector(
+            Stream.FRandRange(-1.0f, 1.0f) * Params.Jitter,
+            Stream.FRandRange(-1.0f, 1.0f) * Params.Jitter,
+            0.0f
+        );
+
+        // Keep wander target on circle
+        InOutTarget.Normalize();
+        InOutTarget *= Params.Radius;
+
+        // Desired velocity toward the target, relative to the facing
+        FVector DesiredVelocity = Facing.RotateVector(InOutTarget + FVector(Params.Distance, 0, 0));
+        DesiredVelocity.Z = 0; // Keep on ground
+        DesiredVelocity.Normalize();
+
+        return DesiredVelocity * Params.Speed - Velocity;
+    }
+
+    FVector LimitVector(FVector Vector, float MaxMagnitude)
+    {
+        if (Vector.SizeSquared() > MaxMagnitude * MaxMagnitude)
+        {
+            Vector.Normalize();
+            Vector *= MaxMagnitude;
+        }
+        return Vector;
+    }
+}
@@ -0,0 +1,95 @@
+// CowHerdKernels.cpp
+#include "CowHerdKernels.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/VectorRegister.h"
+
+static TAutoConsoleVariable<bool> CVarHerdSimdSeparation(
+    TEXT("Herd.SimdSeparation"),
+    true,
+    TEXT("Use the vectorized separation kernel. When false the scalar kernel is used."));
+
+namespace CowHerdKernels
+{
+    void AccumulateSeparationScalar(const float* OffsetX, const float* OffsetY, const float* OffsetZ, int32 Num, float Radius, FSeparationSum& InOutSum)
+    {
+        for (int32 Index = 0; Index < Num; ++Index)
+        {
+            FVector3f ToCow(OffsetX[Index], OffsetY[Index], OffsetZ[Index]);
+            float Distance = ToCow.Size();
+
+            if (Distance > 0 && Distance < Radius)
+            {
+                // Stronger repulsion the closer they are
+                ToCow /= Distance;
+                ToCow *= (Radius - Distance) / Radius;
+                InOutSum.Force += ToCow;
+                InOutSum.Count++;
+            }
+        }
+    }
+
+    void AccumulateSeparationVectorized(const float* OffsetX, const float* OffsetY, const float* OffsetZ, int32 Num, float Radius, FSeparationSum& InOutSum)
+    {
+        const VectorRegister4Float VZero = VectorZeroFloat();
+        const VectorRegister4Float VOne = VectorOneFloat();
+        const VectorRegister4Float VRadius = VectorSetFloat1(Radius);
+        const VectorRegister4Float VInvRadius = VectorSetFloat1(1.0f / Radius);
+
+        VectorRegister4Float SumX = VZero;
+        VectorRegister4Float SumY = VZero;
+        VectorRegister4Float SumZ = VZero;
+        VectorRegister4Float SumCount = VZero;
+
+        int32 Index = 0;
+        for (; Index + 4 <= Num; Index += 4)
+        {
+            const VectorRegister4Float X = VectorLoad(OffsetX + Index);
+            const VectorRegister4Float Y = VectorLoad(OffsetY + Index);
+            const VectorRegister4Float Z = VectorLoad(OffsetZ + Index);
+
+            const VectorRegister4Float DistanceSquared = VectorMultiplyAdd(X, X, VectorMultiplyAdd(Y, Y, VectorMultiply(Z, Z)));
+            const VectorRegister4Float Distance = VectorSqrt(DistanceSquared);
+
+            // Lanes strictly inside the radius and not sitting on top of us
+            const VectorRegister4Float InRange = VectorBitwiseAnd(VectorCompareGT(Distance, VZero), VectorCompareLT(Distance, VRadius));
+
+            // Normalize and apply the falloff in one factor: (Radius - Distance) / (Radius * Distance)
+            const VectorRegister4Float SafeDistance = VectorSelect(InRange, Distance, VOne);
+            const VectorRegister4Float Falloff = VectorMultiply(VectorSubtract(VRadius, Distance), VInvRadius);
+            const VectorRegister4Float Weight = VectorSelect(InRange, VectorDivide(Falloff, SafeDistance), VZero);
+
+            SumX = VectorMultiplyAdd(X, Weight, SumX);
+            SumY = VectorMultiplyAdd(Y, Weight, SumY);
+            SumZ = VectorMultiplyAdd(Z, Weight, SumZ);
+            SumCount = VectorAdd(SumCount, VectorSelect(InRange, VOne, VZero));
+        }
+
+        alignas(16) float Lanes[4];
+
+        VectorStoreAligned(SumX, Lanes);
+        InOutSum.Force.X += (Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]);
+        VectorStoreAligned(SumY, Lanes);
+        InOutSum.Force.Y += (Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]);
+        VectorStoreAligned(SumZ, Lanes);
+        InOutSum.Force.Z += (Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]);
+        VectorStoreAligned(SumCount, Lanes);
+        InOutSum.Count += FMath::RoundToInt32((Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]));
+
+        // Leftover neighbors that don't fill a register
+        AccumulateSeparationScalar(OffsetX + Index, OffsetY + Index, OffsetZ + Index, Num - Index, Radius, InOutSum);
+    }
+
+    void AccumulateSeparation(const float* OffsetX, const float* OffsetY, const float* OffsetZ, int32 Num, float Radius, FSeparationSum& InOutSum)
+    {
+        if (Num <= 0 || Radius <= 0.0f)
+            return;
+
+        if (!CVarHerdSimdSeparation.GetValueOnAnyThread())
+        {
+            AccumulateSeparationScalar(OffsetX, OffsetY, OffsetZ, Num, Radius, InOutSum);
+            return;
+        }
+
+        AccumulateSeparationVectorized(OffsetX, OffsetY, OffsetZ, Num, Radius, InOutSum);
+    }
+}
@@ -0,0 +1,4 @@
+// HerdBoidsModule.cpp
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, HerdBoids);
@@ -0,0 +1,173 @@
+// BoidsSteeringTest.cpp
+#include "BoidsSteering.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    constexpr EAutomationTestFlags SteeringTestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+    // Stop at 100, ease off from 400, full speed 300
+    BoidsSteering::FArriveParams MakeArriveParams()
+    {
+        BoidsSteering::FArriveParams Params;
+        Params.Speed = 300.0f;
+        Params.StopDistance = 100.0f;
+        Params.SlowdownDistance = 400.0f;
+        return Params;
+    }
+
+    BoidsSteering::FWanderParams MakeWanderParams()
+    {
+        BoidsSteering::FWanderParams Params;
+        Params.Speed = 150.0f;
+        Params.Radius = 100.0f;
+        Params.Distance = 200.0f;
+        Params.Jitter = 40.0f;
+        return Params;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBoidsArriveSpeedTest, "HerdBoids.Steering.ArriveSpeed", SteeringTestFlags)
+
+bool FBoidsArriveSpeedTest::RunTest(const FString& Parameters)
+{
+    const BoidsSteering::FArriveParams Params = MakeArriveParams();
+
+    TestEqual(TEXT("Zero distance stops"), BoidsSteering::ArriveSpeed(0.0f, Params), 0.0f);
+    TestEqual(TEXT("Inside the stop distance stops"), BoidsSteering::ArriveSpeed(50.0f, Params), 0.0f);
+    TestEqual(TEXT("At the stop distance stops"), BoidsSteering::ArriveSpeed(100.0f, Params), 0.0f);
+    TestEqual(TEXT("Halfway through the slowdown is half speed"), BoidsSteering::ArriveSpeed(250.0f, Params), 150.0f);
+    TestEqual(TEXT("At the slowdown distance is full speed"), BoidsSteering::ArriveSpeed(400.0f, Params), 300.0f);
+    TestEqual(TEXT("Outside the slowdown is full speed"), BoidsSteering::ArriveSpeed(1000.0f, Params), 300.0f);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBoidsArriveTest, "HerdBoids.Steering.Arrive", SteeringTestFlags)
+
+bool FBoidsArriveTest::RunTest(const FString& Parameters)
+{
+    const BoidsSteering::FArriveParams Params = MakeArriveParams();
+    const FVector Velocity(10.0f, 0.0f, 0.0f);
+
+    // Height of the target is ignored
+    TestEqual(TEXT("Outside the slowdown heads in at full speed"),
+        BoidsSteering::Arrive(FVector::ZeroVector, Velocity, FVector(1000.0f, 0.0f, 50.0f), Params), FVector(290.0f, 0.0f, 0.0f));
+
+    TestEqual(TEXT("Inside the slowdown heads in at reduced speed"),
+        BoidsSteering::Arrive(FVector::ZeroVector, Velocity, FVector(250.0f, 0.0f, 0.0f), Params), FVector(140.0f, 0.0f, 0.0f));
+
+    TestEqual(TEXT("Inside the stop distance brakes"),
+        BoidsSteering::Arrive(FVector::ZeroVector, Velocity, FVector(0.0f, 50.0f, 0.0f), Params), -2.0f * Velocity);
+
+    TestEqual(TEXT("On the target brakes"),
+        BoidsSteering::Arrive(FVector::ZeroVector, Velocity, FVector(0.0f, 0.0f, 500.0f), Params), -2.0f * Velocity);
+
+    // Without a stop distance there is no direction to head in at zero distance either
+    BoidsSteering::FArriveParams NoStop = Params;
+    NoStop.StopDistance = 0.0f;
+    TestEqual(TEXT("On the target without a stop distance brakes"),
+        BoidsSteering::Arrive(FVector::ZeroVector, Velocity, FVector::ZeroVector, NoStop), -2.0f * Velocity);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBoidsFleeTest, "HerdBoids.Steering.Flee", SteeringTestFlags)
+
+bool FBoidsFleeTest::RunTest(const FString& Parameters)
+{
+    const FVector Velocity(0.0f, 10.0f, 0.0f);
+
+    TestEqual(TEXT("Runs straight away along the ground"),
+        BoidsSteering::Flee(FVector(100.0f, 0.0f, 0.0f), Velocity, FVector(0.0f, 0.0f, 80.0f), 200.0f), FVector(200.0f, -10.0f, 0.0f));
+
+    TestEqual(TEXT("No direction on top of the threat"),
+        BoidsSteering::Flee(FVector(100.0f, 0.0f, 0.0f), Velocity, FVector(100.0f, 0.0f, 300.0f), 200.0f), FVector::ZeroVector);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBoidsSeparationTest, "HerdBoids.Steering.Separation", SteeringTestFlags)
+
+bool FBoidsSeparationTest::RunTest(const FString& Parameters)
+{
+    const FVector Velocity(10.0f, 0.0f, 0.0f);
+
+    CowHerdKernels::FSeparationSum Empty;
+    TestEqual(TEXT("No neighbors, no force"), BoidsSteering::Separation(Empty, Velocity, 100.0f), FVector::ZeroVector);
+
+    // Averaged, normalized and driven at full speed
+    CowHerdKernels::FSeparationSum Sum;
+    Sum.Force = FVector3f(3.0f, 4.0f, 0.0f);
+    Sum.Count = 2;
+    TestEqual(TEXT("Pushes along the summed offsets at max speed"), BoidsSteering::Separation(Sum, Velocity, 100.0f), FVector(50.0f, 80.0f, 0.0f));
+
+    // The kernels feed it: two neighbors on the same side push straight away from them
+    const float OffsetX[] = { 30.0f, 60.0f };
+    const float OffsetY[] = { 0.0f, 0.0f };
+    const float OffsetZ[] = { 0.0f, 0.0f };
+    CowHerdKernels::FSeparationSum Kernel;
+    CowHerdKernels::AccumulateSeparation(OffsetX, OffsetY, OffsetZ, 2, 150.0f, Kernel);
+    TestEqual(TEXT("Kernel count"), Kernel.Count, 2);
+    TestEqual(TEXT("Pushes away from the kernel's neighbors"), BoidsSteering::Separation(Kernel, FVector::ZeroVector, 100.0f), FVector(100.0f, 0.0f, 0.0f));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBoidsWanderTest, "HerdBoids.Steering.Wander", SteeringTestFlags)
+
+bool FBoidsWanderTest::RunTest(const FString& Parameters)
+{
+    const BoidsSteering::FWanderParams Params = MakeWanderParams();
+
+    FVector Target(Params.Radius, 0.0f, 0.0f);
+    FRandomStream Stream(1234);
+    for (int32 Step = 0; Step < 100; ++Step)
+    {
+        const FVector Force = BoidsSteering::Wander(Target, Stream, FQuat::Identity, FVector::ZeroVector, Params);
+        if (!TestEqual(TEXT("Target stays on the wander circle"), float(Target.Size()), Params.Radius, 0.01f)
+            || !TestEqual(TEXT("Target stays flat"), float(Target.Z), 0.0f)
+            || !TestEqual(TEXT("Wanders at wander speed from rest"), float(Force.Size()), Params.Speed, 0.01f)
+            || !TestEqual(TEXT("Wanders along the ground"), float(Force.Z), 0.0f)
+            || !TestTrue(TEXT("Wanders ahead of the facing"), Force.X > 0.0f))
+        {
+            break;
+        }
+    }
+
+    // Same seed, same walk
+    FVector TargetA(Params.Radius, 0.0f, 0.0f);
+    FVector TargetB = TargetA;
+    FRandomStream StreamA(99);
+    FRandomStream StreamB(99);
+    for (int32 Step = 0; Step < 10; ++Step)
+    {
+        BoidsSteering::Wander(TargetA, StreamA, FQuat::Identity, FVector::ZeroVector, Params);
+        BoidsSteering::Wander(TargetB, StreamB, FQuat::Identity, FVector::ZeroVector, Params);
+    }
+    TestTrue(TEXT("Seeded streams replay the same target"), TargetA == TargetB);
+
+    // The circle is projected ahead of the facing, not of the world X axis
+    FVector Target90(Params.Radius, 0.0f, 0.0f);
+    FRandomStream Stream90(7);
+    const FVector Turned = BoidsSteering::Wander(Target90, Stream90, FRotator(0.0f, 90.0f, 0.0f).Quaternion(), FVector::ZeroVector, Params);
+    TestTrue(TEXT("Wanders ahead of a turned facing"), Turned.Y > 0.0f);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBoidsLimitVectorTest, "HerdBoids.Steering.LimitVector", SteeringTestFlags)
+
+bool FBoidsLimitVectorTest::RunTest(const FString& Parameters)
+{
+    TestEqual(TEXT("Short vectors pass unchanged"), BoidsSteering::LimitVector(FVector(3.0f, 4.0f, 0.0f), 10.0f), FVector(3.0f, 4.0f, 0.0f));
+    TestEqual(TEXT("Vectors at the limit pass unchanged"), BoidsSteering::LimitVector(FVector(3.0f, 4.0f, 0.0f), 5.0f), FVector(3.0f, 4.0f, 0.0f));
+    TestEqual(TEXT("Long vectors are clamped along their direction"), BoidsSteering::LimitVector(FVector(3.0f, 4.0f, 0.0f), 2.5f), FVector(1.5f, 2.0f, 0.0f));
+    TestEqual(TEXT("Zero stays zero"), BoidsSteering::LimitVector(FVector::ZeroVector, 0.0f), FVector::ZeroVector);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,119 @@
+// CowHerdKernelsTest.cpp
+#include "CowHerdKernels.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    constexpr EAutomationTestFlags KernelTestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+    // Neighbor offsets packed one stream per axis, the way CalculateSeparation hands them to the kernels
+    struct FPackedOffsets
+    {
+        TArray<float> X;
+        TArray<float> Y;
+        TArray<float> Z;
+
+        void Add(float OffsetX, float OffsetY, float OffsetZ)
+        {
+            X.Add(OffsetX);
+            Y.Add(OffsetY);
+            Z.Add(OffsetZ);
+        }
+
+        int32 Num() const { return X.Num(); }
+    };
+
+    // Runs both kernels over the same offsets; they must count the same neighbors and sum the same force
+    void TestKernelsAgree(FAutomationTestBase& Test, const FString& What, const FPackedOffsets& Offsets, float Radius, int32 ExpectedCount)
+    {
+        CowHerdKernels::FSeparationSum Scalar;
+        CowHerdKernels::FSeparationSum Vectorized;
+        CowHerdKernels::AccumulateSeparationScalar(Offsets.X.GetData(), Offsets.Y.GetData(), Offsets.Z.GetData(), Offsets.Num(), Radius, Scalar);
+        CowHerdKernels::AccumulateSeparationVectorized(Offsets.X.GetData(), Offsets.Y.GetData(), Offsets.Z.GetData(), Offsets.Num(), Radius, Vectorized);
+
+        Test.TestEqual(What + TEXT(": scalar count"), Scalar.Count, ExpectedCount);
+        Test.TestEqual(What + TEXT(": vectorized count"), Vectorized.Count, ExpectedCount);
+
+        // Summation order differs between the kernels, allow for float rounding relative to the magnitude
+        const float Tolerance = 1.e-4f * FMath::Max(1.0f, float(Scalar.Count));
+        Test.TestTrue(FString::Printf(TEXT("%s: forces match (scalar %s, vectorized %s)"), *What, *Scalar.Force.ToString(), *Vectorized.Force.ToString()),
+            Scalar.Force.Equals(Vectorized.Force, Tolerance));
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCowHerdSeparationTailLanesTest, "HerdBoids.Kernels.Separation.TailLanes", KernelTestFlags)
+
+bool FCowHerdSeparationTailLanesTest::RunTest(const FString& Parameters)
+{
+    // Every neighbor count from one short of a register to past two, so each tail length runs through the scalar remainder
+    constexpr float Radius = 150.0f;
+    for (int32 Num = 1; Num <= 11; ++Num)
+    {
+        FPackedOffsets Offsets;
+        for (int32 Index = 0; Index < Num; ++Index)
+        {
+            // Spread around the cow, all strictly inside the radius
+            const float Angle = UE_TWO_PI * Index / Num;
+            const float Distance = Radius * (Index + 1) / (Num + 2);
+            Offsets.Add(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 5.0f * Index);
+        }
+
+        TestKernelsAgree(*this, FString::Printf(TEXT("%d neighbors"), Num), Offsets, Radius, Num);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCowHerdSeparationCoincidentTest, "HerdBoids.Kernels.Separation.CoincidentCows", KernelTestFlags)
+
+bool FCowHerdSeparationCoincidentTest::RunTest(const FString& Parameters)
+{
+    // Cows standing on top of each other have no direction to push in and are skipped, in a full register and in the tail
+    FPackedOffsets Offsets;
+    Offsets.Add(40.0f, 0.0f, 0.0f);
+    Offsets.Add(0.0f, 0.0f, 0.0f);
+    Offsets.Add(0.0f, -30.0f, 0.0f);
+    Offsets.Add(-20.0f, 20.0f, 0.0f);
+    Offsets.Add(10.0f, 10.0f, 10.0f);
+    Offsets.Add(0.0f, 0.0f, 0.0f);
+
+    TestKernelsAgree(*this, TEXT("Coincident"), Offsets, 100.0f, 4);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCowHerdSeparationAtRadiusTest, "HerdBoids.Kernels.Separation.AtRadius", KernelTestFlags)
+
+bool FCowHerdSeparationAtRadiusTest::RunTest(const FString& Parameters)
+{
+    // Distances that come out exactly at the radius are outside it; only the last neighbor, just inside, counts
+    FPackedOffsets Offsets;
+    Offsets.Add(100.0f, 0.0f, 0.0f);
+    Offsets.Add(0.0f, -100.0f, 0.0f);
+    Offsets.Add(0.0f, 0.0f, 100.0f);
+    Offsets.Add(60.0f, 80.0f, 0.0f);
+    Offsets.Add(-99.0f, 0.0f, 0.0f);
+
+    TestKernelsAgree(*this, TEXT("At radius"), Offsets, 100.0f, 1);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCowHerdSeparationEmptyTest, "HerdBoids.Kernels.Separation.Empty", KernelTestFlags)
+
+bool FCowHerdSeparationEmptyTest::RunTest(const FString& Parameters)
+{
+    TestKernelsAgree(*this, TEXT("Empty"), FPackedOffsets(), 100.0f, 0);
+
+    // The dispatcher leaves a running sum alone when there is nothing to add
+    CowHerdKernels::FSeparationSum Sum;
+    Sum.Force = FVector3f(1.0f, 2.0f, 3.0f);
+    Sum.Count = 2;
+    CowHerdKernels::AccumulateSeparation(nullptr, nullptr, nullptr, 0, 100.0f, Sum);
+    TestEqual(TEXT("Empty: count untouched"), Sum.Count, 2);
+    TestTrue(TEXT("Empty: force untouched"), Sum.Force.Equals(FVector3f(1.0f, 2.0f, 3.0f)));
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,146 @@
+// HerdBoidsBenchmark.cpp
+#include "BoidsSteering.h"
+#include "CowHerdKernels.h"
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    // A pen-density herd: cows about 60 units apart, so each has a dozen or two others in separation range
+    constexpr int32 NumBenchmarkCows = 2000;
+    constexpr int32 NumBenchmarkIterations = 50;
+    constexpr float BenchmarkSpacing = 60.0f;
+    constexpr float BenchmarkSeparationRadius = 150.0f;
+    constexpr float BenchmarkDeltaTime = 1.0f / 60.0f;
+
+    // Average wall time of one call of Body, in milliseconds
+    template<typename BodyType>
+    double TimeIterationsMs(BodyType&& Body)
+    {
+        const double Start = FPlatformTime::Seconds();
+        for (int32 Iteration = 0; Iteration < NumBenchmarkIterations; ++Iteration)
+        {
+            Body();
+        }
+        return (FPlatformTime::Seconds() - Start) * 1000.0 / NumBenchmarkIterations;
+    }
+}
+
+/**
+ *  Times the steering math over a fixed herd without a world, for comparing kernel changes on the same machine:
+ *    UnrealEditor-Cmd SpaceShepherd.uproject -ExecCmds="Automation RunTests HerdBoids.Benchmark;Quit" -nullrhi -unattended
+ *  Results go to the automation log as milliseconds per herd update.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHerdBoidsBenchmarkTest, "HerdBoids.Benchmark.Steering", EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FHerdBoidsBenchmarkTest::RunTest(const FString& Parameters)
+{
+    FRandomStream Stream(0x5EED);
+    const float Extent = FMath::Sqrt(float(NumBenchmarkCows)) * BenchmarkSpacing;
+
+    TArray<FVector> Positions;
+    TArray<FVector> Velocities;
+    TArray<FVector> WanderTargets;
+    TArray<FRandomStream> RandomStreams;
+    for (int32 Cow = 0; Cow < NumBenchmarkCows; ++Cow)
+    {
+        Positions.Add(FVector(Stream.FRandRange(0.0f, Extent), Stream.FRandRange(0.0f, Extent), 0.0f));
+        Velocities.Add(FVector(Stream.FRandRange(-100.0f, 100.0f), Stream.FRandRange(-100.0f, 100.0f), 0.0f));
+        WanderTargets.Add(FVector(100.0f, 0.0f, 0.0f));
+        RandomStreams.Add(FRandomStream(Cow));
+    }
+
+    // Neighbor offsets packed per cow up front, the way the herd's neighbor lists feed the kernels; not part of the timing
+    TArray<int32> NeighborStarts;
+    TArray<float> OffsetX;
+    TArray<float> OffsetY;
+    TArray<float> OffsetZ;
+    for (int32 Cow = 0; Cow < NumBenchmarkCows; ++Cow)
+    {
+        NeighborStarts.Add(OffsetX.Num());
+        for (int32 Other = 0; Other < NumBenchmarkCows; ++Other)
+        {
+            const FVector Offset = Positions[Cow] - Positions[Other];
+            if (Other != Cow && Offset.SizeSquared() < FMath::Square(BenchmarkSeparationRadius + 50.0f))
+            {
+                OffsetX.Add(float(Offset.X));
+                OffsetY.Add(float(Offset.Y));
+                OffsetZ.Add(float(Offset.Z));
+            }
+        }
+    }
+    NeighborStarts.Add(OffsetX.Num());
+
+    auto Separate = [&](int32 Cow, auto&& Kernel)
+    {
+        const int32 First = NeighborStarts[Cow];
+        CowHerdKernels::FSeparationSum Sum;
+        Kernel(OffsetX.GetData() + First, OffsetY.GetData() + First, OffsetZ.GetData() + First, NeighborStarts[Cow + 1] - First, BenchmarkSeparationRadius, Sum);
+        return Sum;
+    };
+
+    // Keeps the optimizer from dropping the work
+    double Sink = 0.0;
+
+    const double ScalarMs = TimeIterationsMs([&]()
+    {
+        for (int32 Cow = 0; Cow < NumBenchmarkCows; ++Cow)
+        {
+            Sink += Separate(Cow, &CowHerdKernels::AccumulateSeparationScalar).Force.X;
+        }
+    });
+
+    const double VectorizedMs = TimeIterationsMs([&]()
+    {
+        for (int32 Cow = 0; Cow < NumBenchmarkCows; ++Cow)
+        {
+            Sink += Separate(Cow, &CowHerdKernels::AccumulateSeparationVectorized).Force.X;
+        }
+    });
+
+    // Everything a cow chasing a lure next to a repelling shepherd runs per update
+    BoidsSteering::FArriveParams ArriveParams;
+    ArriveParams.Speed = 300.0f;
+    ArriveParams.StopDistance = 100.0f;
+    ArriveParams.SlowdownDistance = 400.0f;
+
+    BoidsSteering::FWanderParams WanderParams;
+    WanderParams.Speed = 150.0f;
+    WanderParams.Radius = 100.0f;
+    WanderParams.Distance = 200.0f;
+    WanderParams.Jitter = 40.0f;
+
+    const FVector Lure(Extent * 0.5f, Extent * 0.5f, 0.0f);
+    const FVector Threat(0.0f, 0.0f, 0.0f);
+
+    const double SteeringMs = TimeIterationsMs([&]()
+    {
+        for (int32 Cow = 0; Cow < NumBenchmarkCows; ++Cow)
+        {
+            const FVector& Location = Positions[Cow];
+            FVector& Velocity = Velocities[Cow];
+
+            const CowHerdKernels::FSeparationSum Sum = Separate(Cow, &CowHerdKernels::AccumulateSeparation);
+            FVector Force = BoidsSteering::Separation(Sum, Velocity, 300.0f) * 2.0f;
+            Force += BoidsSteering::Arrive(Location, Velocity, Lure, ArriveParams);
+            Force += BoidsSteering::Flee(Location, Velocity, Threat, 300.0f);
+            Force += BoidsSteering::Wander(WanderTargets[Cow], RandomStreams[Cow], FQuat::Identity, Velocity, WanderParams);
+            Force = BoidsSteering::LimitVector(Force, 150.0f);
+
+            Velocity = BoidsSteering::LimitVector(Velocity + Force * BenchmarkDeltaTime, 300.0f);
+            Sink += Velocity.X;
+        }
+    });
+
+    AddInfo(FString::Printf(TEXT("%d cows, %d neighbor entries, %d iterations"), NumBenchmarkCows, OffsetX.Num(), NumBenchmarkIterations));
+    AddInfo(FString::Printf(TEXT("Scalar separation: %.3f ms per update"), ScalarMs));
+    AddInfo(FString::Printf(TEXT("Vectorized separation: %.3f ms per update (%.2fx)"), VectorizedMs, ScalarMs / FMath::Max(VectorizedMs, UE_SMALL_NUMBER)));
+    AddInfo(FString::Printf(TEXT("Full steering: %.3f ms per update"), SteeringMs));
+
+    TestTrue(TEXT("Results are finite"), FMath::IsFinite(Sink));
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
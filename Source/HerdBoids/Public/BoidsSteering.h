@@ -0,0 +1,56 @@
+// BoidsSteering.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CowHerdKernels.h"
+
+/**
+ *  Steering rules for a single boid, free of actors, worlds and scene queries.
+ *  Each rule returns a steering force: the velocity it wants minus the current velocity.
+ *  Target-driven rules work in the ground plane; Z of the target offset is ignored.
+ */
+namespace BoidsSteering
+{
+    struct FArriveParams
+    {
+        float Speed = 0.0f;
+        float StopDistance = 0.0f;
+        float SlowdownDistance = 0.0f;
+    };
+
+    struct FWanderParams
+    {
+        float Speed = 0.0f;
+        float Radius = 0.0f;
+        float Distance = 0.0f;
+        float Jitter = 0.0f;
+    };
+
+    // Speed to approach a target at from Distance away: zero inside StopDistance,
+    // ramping up linearly to Speed at SlowdownDistance
+    HERDBOIDS_API float ArriveSpeed(float Distance, const FArriveParams& Params);
+
+    // Head for Target, easing off inside SlowdownDistance and braking hard inside StopDistance
+    HERDBOIDS_API FVector Arrive(const FVector& Location, const FVector& Velocity, const FVector& Target, const FArriveParams& Params);
+
+    // Run straight away from Threat at Speed
+    HERDBOIDS_API FVector Flee(const FVector& Location, const FVector& Velocity, const FVector& Threat, float Speed);
+
+    // Move along Direction (unit or zero) at Speed
+    HERDBOIDS_API FVector Steer(const FVector& Direction, const FVector& Velocity, float Speed);
+
+    // Turn a separation sum from CowHerdKernels into a force at MaxSpeed, zero without neighbors
+    HERDBOIDS_API FVector Separation(const CowHerdKernels::FSeparationSum& Sum, const FVector& Velocity, float MaxSpeed);
+
+    // Match the neighbors' average heading at MaxSpeed, zero when they stand still
+    HERDBOIDS_API FVector Alignment(const FVector& AverageVelocity, const FVector& Velocity, float MaxSpeed);
+
+    // Head for the neighbors' centroid at MaxSpeed
+    HERDBOIDS_API FVector Cohesion(const FVector& Location, const FVector& Velocity, const FVector& Centroid, float MaxSpeed);
+
+    // Jitter InOutTarget on the wander circle, then steer toward it projected Params.Distance ahead of Facing
+    HERDBOIDS_API FVector Wander(FVector& InOutTarget, FRandomStream& Stream, const FQuat& Facing, const FVector& Velocity, const FWanderParams& Params);
+
+    // Clamp the length of Vector to MaxMagnitude
+    HERDBOIDS_API FVector LimitVector(FVector Vector, float MaxMagnitude);
+}
@@ -0,0 +1,28 @@
+// CowHerdKernels.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ *  Inner loops of the herd simulation, written against packed float streams so they vectorize.
+ *  Neighbor data is passed as offsets relative to the cow being steered, which keeps float precision on large maps.
+ */
+namespace CowHerdKernels
+{
+    // Running separation sum over one or more batches of neighbors
+    struct FSeparationSum
+    {
+        FVector3f Force = FVector3f::ZeroVector;
+        int32 Count = 0;
+    };
+
+    // Offsets are (self - neighbor). Each neighbor strictly inside Radius adds its normalized offset
+    // scaled by (Radius - Distance) / Radius, exactly like the original per-actor separation loop.
+    HERDBOIDS_API void AccumulateSeparationScalar(const float* OffsetX, const float* OffsetY, const float* OffsetZ, int32 Num, float Radius, FSeparationSum& InOutSum);
+
+    // Same result as the scalar kernel, four neighbors per instruction with a scalar tail
+    HERDBOIDS_API void AccumulateSeparationVectorized(const float* OffsetX, const float* OffsetY, const float* OffsetZ, int32 Num, float Radius, FSeparationSum& InOutSum);
+
+    // Runs the vectorized kernel unless Herd.SimdSeparation is off
+    HERDBOIDS_API void AccumulateSeparation(const float* OffsetX, const float* OffsetY, const float* OffsetZ, int32 Num, float Radius, FSeparationSum& InOutSum);
+}
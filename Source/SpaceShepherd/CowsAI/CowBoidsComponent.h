@@ -15,7 +15,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
-    virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
     // Boids Parameters
@@ -53,6 +53,13 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Boids|Avoidance")
     float SafetyPriorityMultiplier = 3.0f;
 
+    // Flocking, from the herd grid's per-cell sums around the cow
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Boids|Flocking")
+    float AlignmentWeight = 0.5f;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Boids|Flocking")
+    float CohesionWeight = 0.3f;
+
     // Perception
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Boids|Perception")
     float PerceptionRadius = 500.0f;
@@ -101,43 +108,34 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Boids|Laser")
     float LaserSlowdownDistance = 300.0f;
 
-private:
-    // Internal state
-    FVector CurrentVelocity;
-    FVector WanderTarget;
-    float CurrentMaxSpeed;
-    class ACharacter* OwnerCharacter;
-    class UCharacterMovementComponent* MovementComponent;
-    class AActor* DetectedPlayer;
-    class UPlayerShepherdComponent* ShepherdComponent;
-    bool bPlayerInRange;
-    bool bIsAvoidingObstacle;
-    bool bIsAvoidingCliff;
-    bool bIsLaserActive;
-    FVector LaserAttractionPoint;
+    // Pen Homing Parameters
+    // Follow the herd's flow field toward the closest pen (pen assist does this for every cow)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Boids|Homing")
+    bool bHomeToPen = false;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Boids|Homing")
+    float HomingWeight = 0.5f;
 
-    // Core boids functions
-    FVector CalculateSteeringForce(float DeltaTime);
-    FVector CalculateSeparation();
-    FVector CalculateWander(float DeltaTime);
-    FVector CalculateObstacleAvoidance();
-    FVector CalculateCliffAvoidance();
-    FVector CalculatePlayerAttraction();
-    FVector CalculatePlayerRepulsion();
-    FVector CalculateLaserAttraction();
-    
-    // Helper functions
-    TArray<AActor*> GetNearbyCows();
-    void UpdatePlayerDetection();
-    void UpdateLaserDetection();
-    void UpdateMaxSpeed(float DeltaTime);
-    bool IsGroundAhead(FVector Direction, float Distance);
-    bool IsObstacleAhead(FVector Direction, float Distance);
-    FVector LimitVector(FVector Vector, float MaxMagnitude);
+    // Enable or disable boids steering for this cow (e.g. while carried or airborne)
+    UFUNCTION(BlueprintCallable, Category = "Boids")
+    void SetBoidsEnabled(bool bEnabled);
+    
+    UFUNCTION(BlueprintPure, Category = "Boids")
+    bool IsBoidsEnabled() const;
+    
+    UFUNCTION(BlueprintPure, Category = "Boids")
+    FVector GetBoidsVelocity() const;
+
+private:
+    friend class UCowHerdSubsystem;
+    
+    // Slot in the herd subsystem buffers, INDEX_NONE while unregistered
+    int32 HerdIndex = INDEX_NONE;
+    
+    UPROPERTY()
+    class UCowHerdSubsystem* HerdSubsystem;
     
     // Debug
     UPROPERTY(EditAnywhere, Category = "Debug")
     bool bDebugDraw = false;
-    
-    void DrawDebugInfo();
 };
\ No newline at end of file
@@ -33,7 +33,7 @@ protected:
 	float TurnRate = 180.0f;
 
 public:
-	// Player interaction states (for future use)
+	// Player interaction states, mirrored by the herd from its influence map for Blueprints and animation
 	UPROPERTY(BlueprintReadWrite, Category = "AI")
 	bool bIsAttractedToPlayer = false;
     
@@ -0,0 +1,395 @@
+// CowHerdBenchmark.cpp
+#include "CowHerdBenchmark.h"
+#include "CowCharacter.h"
+#include "PlayerShepherdComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+    bool IsBenchmarkRequested()
+    {
+        FString Sizes;
+        return FParse::Param(FCommandLine::Get(), TEXT("HerdBenchmark"))
+            || FParse::Value(FCommandLine::Get(), TEXT("HerdBenchmark="), Sizes);
+    }
+
+    void AddStats(FCowHerdTickStats& Sum, const FCowHerdTickStats& Stats)
+    {
+        Sum.GatherMs += Stats.GatherMs;
+        Sum.GridMs += Stats.GridMs;
+        Sum.ShepherdMs += Stats.ShepherdMs;
+        Sum.FlowFieldMs += Stats.FlowFieldMs;
+        Sum.DetectionMs += Stats.DetectionMs;
+        Sum.LODMs += Stats.LODMs;
+        Sum.SensingMs += Stats.SensingMs;
+        Sum.SteeringMs += Stats.SteeringMs;
+        Sum.ApplyMs += Stats.ApplyMs;
+        Sum.TotalMs += Stats.TotalMs;
+        Sum.NumSceneQueries += Stats.NumSceneQueries;
+        Sum.NumSensed += Stats.NumSensed;
+        Sum.NumKinematic += Stats.NumKinematic;
+        Sum.NumNeighborListBuilds += Stats.NumNeighborListBuilds;
+        Sum.NumCowsTicked += Stats.NumCowsTicked;
+        Sum.NumNeighborsVisited += Stats.NumNeighborsVisited;
+        Sum.NumInfluenceCells += Stats.NumInfluenceCells;
+    }
+
+    // Nearest rank percentile of an already sorted array
+    float GetPercentile(const TArray<float>& Sorted, float Percentile)
+    {
+        if (Sorted.Num() == 0)
+            return 0.0f;
+
+        const int32 Rank = FMath::CeilToInt32(Percentile * Sorted.Num()) - 1;
+        return Sorted[FMath::Clamp(Rank, 0, Sorted.Num() - 1)];
+    }
+
+    // Cows are laid out on a square grid this far apart
+    constexpr float CowSpacing = 200.0f;
+
+    // How long to wait for the player's shepherd to show up before giving up
+    constexpr int32 MaxShepherdWaitFrames = 300;
+}
+
+bool UCowHerdBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    return Super::ShouldCreateSubsystem(Outer) && IsBenchmarkRequested();
+}
+
+bool UCowHerdBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCowHerdBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    const TCHAR* CommandLine = FCommandLine::Get();
+
+    FString SizesString;
+    if (FParse::Value(CommandLine, TEXT("HerdBenchmark="), SizesString, false))
+    {
+        TArray<FString> Sizes;
+        SizesString.ParseIntoArray(Sizes, TEXT(","));
+        for (const FString& Size : Sizes)
+        {
+            const int32 NumCows = FCString::Atoi(*Size);
+            if (NumCows > 0)
+            {
+                HerdSizes.Add(NumCows);
+            }
+        }
+    }
+    if (HerdSizes.Num() == 0)
+    {
+        HerdSizes = { 100, 500, 1000, 5000 };
+    }
+
+    FParse::Value(CommandLine, TEXT("HerdBenchmarkFrames="), FramesPerPhase);
+    FParse::Value(CommandLine, TEXT("HerdBenchmarkWarmup="), WarmupFrames);
+    FramesPerPhase = FMath::Max(FramesPerPhase, 1);
+    WarmupFrames = FMath::Max(WarmupFrames, 0);
+
+    if (!FParse::Value(CommandLine, TEXT("HerdBenchmarkOut="), OutputPath))
+    {
+        OutputPath = FPaths::ProfilingDir() / TEXT("HerdBenchmark.csv");
+    }
+
+    FString CowClassPath;
+    if (FParse::Value(CommandLine, TEXT("HerdBenchmarkCow="), CowClassPath))
+    {
+        CowClass = LoadClass<ACowCharacter>(nullptr, *CowClassPath);
+        if (!CowClass)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("CowHerdBenchmark: could not load cow class %s, using ACowCharacter"), *CowClassPath);
+        }
+    }
+    if (!CowClass)
+    {
+        CowClass = ACowCharacter::StaticClass();
+    }
+
+    bRunning = true;
+    LastFrameTime = FPlatformTime::Seconds();
+
+    UE_LOG(LogTemp, Log, TEXT("CowHerdBenchmark: %d herd sizes, %d warmup and %d frames per phase"), HerdSizes.Num(), WarmupFrames, FramesPerPhase);
+}
+
+TStatId UCowHerdBenchmarkSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UCowHerdBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+void UCowHerdBenchmarkSubsystem::Tick(float DeltaTime)
+{
+    // Wall time between benchmark ticks is the frame time, whatever the engine reports as delta
+    const double Now = FPlatformTime::Seconds();
+    const float FrameMs = float((Now - LastFrameTime) * 1000.0);
+    LastFrameTime = Now;
+
+    if (!bRunning)
+        return;
+
+    // The player's pawn may spawn a few frames after the world starts
+    if (!Shepherd)
+    {
+        const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+        const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+        Shepherd = Pawn ? Pawn->FindComponentByClass<UPlayerShepherdComponent>() : nullptr;
+
+        if (Shepherd)
+        {
+            StartNextSize();
+        }
+        else if (++PhaseFrame > MaxShepherdWaitFrames)
+        {
+            UE_LOG(LogTemp, Error, TEXT("CowHerdBenchmark: the player pawn has no UPlayerShepherdComponent"));
+            Finish(false);
+        }
+        return;
+    }
+
+    if (Phase != EPhase::Warmup)
+    {
+        RecordFrame(FrameMs);
+    }
+
+    DriveShepherd(DeltaTime);
+
+    const int32 PhaseFrames = Phase == EPhase::Warmup ? WarmupFrames : FramesPerPhase;
+    if (++PhaseFrame < PhaseFrames)
+        return;
+
+    switch (Phase)
+    {
+    case EPhase::Warmup:
+        EnterPhase(EPhase::Attraction);
+        break;
+
+    case EPhase::Attraction:
+        EnterPhase(EPhase::Repulsion);
+        break;
+
+    case EPhase::Repulsion:
+        EnterPhase(EPhase::Laser);
+        break;
+
+    default:
+        EnterPhase(EPhase::Done);
+        DestroyHerd();
+        if (!StartNextSize())
+        {
+            Finish(true);
+        }
+        break;
+    }
+}
+
+bool UCowHerdBenchmarkSubsystem::StartNextSize()
+{
+    if (!HerdSizes.IsValidIndex(++SizeIndex))
+        return false;
+
+    SpawnHerd(HerdSizes[SizeIndex]);
+    EnterPhase(EPhase::Warmup);
+    return true;
+}
+
+void UCowHerdBenchmarkSubsystem::SpawnHerd(int32 NumCows)
+{
+    // A square block of cows in front of the shepherd; the shepherd circles just outside it
+    const AActor* ShepherdActor = Shepherd->GetOwner();
+    const FVector Start = ShepherdActor->GetActorLocation();
+    const int32 Side = FMath::CeilToInt32(FMath::Sqrt(float(NumCows)));
+    const float HalfExtent = Side * CowSpacing * 0.5f;
+
+    OrbitRadius = HalfExtent + 500.0f;
+    HerdCenter = Start + ShepherdActor->GetActorForwardVector().GetSafeNormal2D() * OrbitRadius;
+    OrbitAngle = FMath::Atan2(Start.Y - HerdCenter.Y, Start.X - HerdCenter.X);
+
+    // Same layout and headings every run
+    FRandomStream HeadingStream(NumCows);
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+    SpawnedCows.Reserve(NumCows);
+    for (int32 Cow = 0; Cow < NumCows; ++Cow)
+    {
+        const FVector Location = HerdCenter + FVector(
+            ((Cow % Side) + 0.5f) * CowSpacing - HalfExtent,
+            ((Cow / Side) + 0.5f) * CowSpacing - HalfExtent,
+            0.0f);
+        const FRotator Rotation(0.0f, HeadingStream.FRandRange(0.0f, 360.0f), 0.0f);
+
+        if (ACowCharacter* Spawned = GetWorld()->SpawnActor<ACowCharacter>(CowClass, Location, Rotation, SpawnParams))
+        {
+            SpawnedCows.Add(Spawned);
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("CowHerdBenchmark: spawned %d of %d cows"), SpawnedCows.Num(), NumCows);
+}
+
+void UCowHerdBenchmarkSubsystem::DestroyHerd()
+{
+    for (ACowCharacter* Cow : SpawnedCows)
+    {
+        if (IsValid(Cow))
+        {
+            Cow->Destroy();
+        }
+    }
+    SpawnedCows.Reset();
+}
+
+void UCowHerdBenchmarkSubsystem::EnterPhase(EPhase NewPhase)
+{
+    if (Shepherd)
+    {
+        Shepherd->StopLaserAttraction();
+
+        switch (NewPhase)
+        {
+        case EPhase::Attraction:
+            Shepherd->SetShepherdMode(EShepherdMode::Attraction);
+            break;
+
+        case EPhase::Repulsion:
+            Shepherd->SetShepherdMode(EShepherdMode::Repulsion);
+            break;
+
+        case EPhase::Laser:
+            Shepherd->StartLaserAttraction();
+            break;
+
+        default:
+            Shepherd->SetNeutralMode();
+            break;
+        }
+    }
+
+    Phase = NewPhase;
+    PhaseFrame = 0;
+
+    if (Phase != EPhase::Warmup && Phase != EPhase::Done)
+    {
+        FPhaseResult& Result = Results.AddDefaulted_GetRef();
+        Result.NumCows = SpawnedCows.Num();
+        Result.Phase = Phase;
+        Result.FrameMs.Reserve(FramesPerPhase);
+    }
+}
+
+void UCowHerdBenchmarkSubsystem::DriveShepherd(float DeltaTime)
+{
+    // Circle the herd at a steady walking pace so every phase sweeps over fresh cows
+    AActor* ShepherdActor = Shepherd->GetOwner();
+    OrbitAngle += DeltaTime * 600.0f / OrbitRadius;
+
+    const FVector Location = HerdCenter + FVector(FMath::Cos(OrbitAngle), FMath::Sin(OrbitAngle), 0.0f) * OrbitRadius;
+    ShepherdActor->SetActorLocation(Location, false, nullptr, ETeleportType::TeleportPhysics);
+
+    // Look at the ground a little way into the herd, which is where the laser lands
+    const FVector ToCenter = (HerdCenter - Location).GetSafeNormal2D();
+    const FVector LookAt = Location + ToCenter * FMath::Min(1500.0f, OrbitRadius) - FVector(0.0f, 0.0f, 100.0f);
+    const FRotator LookRotation = (LookAt - Location).Rotation();
+
+    ShepherdActor->SetActorRotation(FRotator(0.0f, LookRotation.Yaw, 0.0f));
+    if (const APawn* Pawn = Cast<APawn>(ShepherdActor))
+    {
+        if (AController* Controller = Pawn->GetController())
+        {
+            Controller->SetControlRotation(LookRotation);
+        }
+    }
+}
+
+void UCowHerdBenchmarkSubsystem::RecordFrame(float FrameMs)
+{
+    if (Results.Num() == 0)
+        return;
+
+    FPhaseResult& Result = Results.Last();
+    Result.FrameMs.Add(FrameMs);
+
+    if (const UCowHerdSubsystem* HerdSubsystem = GetWorld()->GetSubsystem<UCowHerdSubsystem>())
+    {
+        AddStats(Result.HerdSum, HerdSubsystem->GetLastTickStats());
+    }
+}
+
+void UCowHerdBenchmarkSubsystem::WriteResults() const
+{
+    FString Csv = TEXT("Cows,Phase,Frames,FrameMeanMs,FrameP50Ms,FrameP95Ms,FrameP99Ms,HerdMs,GatherMs,GridMs,ShepherdMs,FlowFieldMs,DetectionMs,LODMs,SensingMs,SteeringMs,ApplyMs,QueriesPerFrame,SensedPerFrame,KinematicPerFrame,NeighborListBuildsPerFrame,CowsTickedPerFrame,NeighborsVisitedPerFrame,InfluenceCellsPerFrame\n");
+
+    for (const FPhaseResult& Result : Results)
+    {
+        const int32 NumFrames = Result.FrameMs.Num();
+        if (NumFrames == 0)
+            continue;
+
+        TArray<float> Sorted = Result.FrameMs;
+        Sorted.Sort();
+
+        double FrameSum = 0.0;
+        for (const float FrameMs : Sorted)
+        {
+            FrameSum += FrameMs;
+        }
+
+        const FCowHerdTickStats& Sum = Result.HerdSum;
+        const double Scale = 1.0 / NumFrames;
+
+        Csv += FString::Printf(TEXT("%d,%s,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.1f,%.1f,%.1f,%.3f,%.1f,%.1f,%.1f\n"),
+            Result.NumCows, GetPhaseName(Result.Phase), NumFrames,
+            FrameSum * Scale, GetPercentile(Sorted, 0.5f), GetPercentile(Sorted, 0.95f), GetPercentile(Sorted, 0.99f),
+            Sum.TotalMs * Scale, Sum.GatherMs * Scale, Sum.GridMs * Scale, Sum.ShepherdMs * Scale, Sum.FlowFieldMs * Scale,
+            Sum.DetectionMs * Scale, Sum.LODMs * Scale, Sum.SensingMs * Scale, Sum.SteeringMs * Scale, Sum.ApplyMs * Scale,
+            Sum.NumSceneQueries * Scale, Sum.NumSensed * Scale, Sum.NumKinematic * Scale, Sum.NumNeighborListBuilds * Scale,
+            Sum.NumCowsTicked * Scale, Sum.NumNeighborsVisited * Scale, Sum.NumInfluenceCells * Scale);
+    }
+
+    if (FFileHelper::SaveStringToFile(Csv, *OutputPath))
+    {
+        UE_LOG(LogTemp, Log, TEXT("CowHerdBenchmark: wrote %s"), *OutputPath);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("CowHerdBenchmark: could not write %s"), *OutputPath);
+    }
+}
+
+void UCowHerdBenchmarkSubsystem::Finish(bool bSuccess)
+{
+    bRunning = false;
+    EnterPhase(EPhase::Done);
+    DestroyHerd();
+
+    if (bSuccess)
+    {
+        WriteResults();
+    }
+
+    FPlatformMisc::RequestExitWithStatus(false, bSuccess ? 0 : 1);
+}
+
+const TCHAR* UCowHerdBenchmarkSubsystem::GetPhaseName(EPhase Phase)
+{
+    switch (Phase)
+    {
+    case EPhase::Attraction:    return TEXT("Attraction");
+    case EPhase::Repulsion:     return TEXT("Repulsion");
+    case EPhase::Laser:         return TEXT("Laser");
+    case EPhase::Warmup:        return TEXT("Warmup");
+    default:                    return TEXT("Done");
+    }
+}
@@ -0,0 +1,91 @@
+// CowHerdBenchmark.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CowHerdSubsystem.h"
+#include "CowHerdBenchmark.generated.h"
+
+class ACowCharacter;
+class UPlayerShepherdComponent;
+
+/**
+ *  Headless herd scaling benchmark. It only exists when the game runs with -HerdBenchmark, for example:
+ *    SpaceShepherd /Game/Maps/FlatMap -game -nullrhi -unattended -benchmark -fps=60 -HerdBenchmark=100,500,1000,5000
+ *  For each herd size it spawns the cows in front of the player's shepherd, circles the shepherd around them
+ *  through attraction, repulsion and laser phases, then writes frame time percentiles, herd stage times and
+ *  scene query counts to a CSV and quits.
+ *
+ *  Options: -HerdBenchmarkFrames= frames per phase (300), -HerdBenchmarkWarmup= frames before measuring (60),
+ *  -HerdBenchmarkCow= cow class path (native ACowCharacter by default),
+ *  -HerdBenchmarkOut= CSV path (Saved/Profiling/HerdBenchmark.csv).
+ */
+UCLASS()
+class UCowHerdBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+private:
+    enum class EPhase : uint8
+    {
+        Warmup,
+        Attraction,
+        Repulsion,
+        Laser,
+        Done
+    };
+
+    // Everything measured over one phase of one herd size
+    struct FPhaseResult
+    {
+        int32 NumCows = 0;
+        EPhase Phase = EPhase::Warmup;
+        TArray<float> FrameMs;
+        FCowHerdTickStats HerdSum;
+    };
+
+    bool StartNextSize();
+    void SpawnHerd(int32 NumCows);
+    void DestroyHerd();
+    void EnterPhase(EPhase NewPhase);
+    void DriveShepherd(float DeltaTime);
+    void RecordFrame(float FrameMs);
+    void WriteResults() const;
+    void Finish(bool bSuccess);
+
+    static const TCHAR* GetPhaseName(EPhase Phase);
+
+    // Settings from the command line
+    TArray<int32> HerdSizes;
+    int32 FramesPerPhase = 300;
+    int32 WarmupFrames = 60;
+    FString OutputPath;
+
+    UPROPERTY(Transient)
+    TSubclassOf<ACowCharacter> CowClass;
+
+    UPROPERTY(Transient)
+    UPlayerShepherdComponent* Shepherd = nullptr;
+
+    UPROPERTY(Transient)
+    TArray<ACowCharacter*> SpawnedCows;
+
+    // Progress
+    bool bRunning = false;
+    int32 SizeIndex = INDEX_NONE;
+    EPhase Phase = EPhase::Done;
+    int32 PhaseFrame = 0;
+    double LastFrameTime = 0.0;
+    FVector HerdCenter = FVector::ZeroVector;
+    float OrbitRadius = 1000.0f;
+    float OrbitAngle = 0.0f;
+
+    TArray<FPhaseResult> Results;
+};
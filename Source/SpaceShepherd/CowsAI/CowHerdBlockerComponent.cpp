@@ -0,0 +1,39 @@
+// CowHerdBlockerComponent.cpp
+#include "CowHerdBlockerComponent.h"
+#include "CowHerdSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+
+UCowHerdBlockerComponent::UCowHerdBlockerComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UCowHerdBlockerComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (BlockerRadius <= 0.0f)
+    {
+        FVector Origin, Extent;
+        GetOwner()->GetActorBounds(true, Origin, Extent);
+        BlockerRadius = FVector2D(Extent).Size();
+    }
+
+    HerdSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UCowHerdSubsystem>() : nullptr;
+    if (HerdSubsystem)
+    {
+        HerdSubsystem->RegisterBlocker(this);
+    }
+}
+
+void UCowHerdBlockerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (HerdSubsystem)
+    {
+        HerdSubsystem->UnregisterBlocker(this);
+        HerdSubsystem = nullptr;
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
@@ -0,0 +1,31 @@
+// CowHerdBlockerComponent.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "CowHerdBlockerComponent.generated.h"
+
+/**
+ *  Makes a moving or spawned actor something the herd steers around without tracing for it, inside
+ *  baked fields and out. The blocker is treated as a circle on the ground around its owner.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class UCowHerdBlockerComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UCowHerdBlockerComponent();
+
+    // Radius the herd keeps clear of; 0 fits a circle around the owner's collision bounds at BeginPlay
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Herd Blocker", meta = (ClampMin = "0.0"))
+    float BlockerRadius = 0.0f;
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+    UPROPERTY()
+    class UCowHerdSubsystem* HerdSubsystem = nullptr;
+};
@@ -0,0 +1,184 @@
+// CowHerdFieldBake.cpp
+#include "CowHerdFieldBake.h"
+
+#if WITH_EDITOR
+
+namespace CowHerdFieldBake
+{
+    void ComputeDistanceTransform(const UCowHerdFieldData& Field, TArray<float>& Distances)
+    {
+        const float Straight = Field.CellSize;
+        const float Diagonal = Field.CellSize * UE_SQRT_2;
+
+        auto Relax = [&](int32 X, int32 Y, int32 OffsetX, int32 OffsetY, float Cost)
+        {
+            const int32 NeighborX = X + OffsetX;
+            const int32 NeighborY = Y + OffsetY;
+            if (NeighborX < 0 || NeighborY < 0 || NeighborX >= Field.SizeX || NeighborY >= Field.SizeY)
+                return;
+
+            float& Distance = Distances[Field.GetCellIndex(X, Y)];
+            Distance = FMath::Min(Distance, Distances[Field.GetCellIndex(NeighborX, NeighborY)] + Cost);
+        };
+
+        for (int32 Y = 0; Y < Field.SizeY; ++Y)
+        {
+            for (int32 X = 0; X < Field.SizeX; ++X)
+            {
+                Relax(X, Y, -1, 0, Straight);
+                Relax(X, Y, 0, -1, Straight);
+                Relax(X, Y, -1, -1, Diagonal);
+                Relax(X, Y, 1, -1, Diagonal);
+            }
+        }
+
+        for (int32 Y = Field.SizeY - 1; Y >= 0; --Y)
+        {
+            for (int32 X = Field.SizeX - 1; X >= 0; --X)
+            {
+                Relax(X, Y, 1, 0, Straight);
+                Relax(X, Y, 0, 1, Straight);
+                Relax(X, Y, 1, 1, Diagonal);
+                Relax(X, Y, -1, 1, Diagonal);
+            }
+        }
+    }
+
+    void BakeGround(UCowHerdFieldData& Field, TConstArrayView<FCowHerdFieldColumn> Columns, float MaxStepHeight, TArray<bool>& OutObstacles)
+    {
+        const int32 NumCells = Field.SizeX * Field.SizeY;
+        check(Columns.Num() == NumCells);
+
+        Field.GroundHeights.SetNumUninitialized(NumCells);
+        OutObstacles.Init(false, NumCells);
+
+        for (int32 Y = 0; Y < Field.SizeY; ++Y)
+        {
+            for (int32 X = 0; X < Field.SizeX; ++X)
+            {
+                const int32 Cell = Field.GetCellIndex(X, Y);
+                const FCowHerdFieldColumn& Column = Columns[Cell];
+                float& Ground = Field.GroundHeights[Cell];
+
+                if (Column.TopHeight == UCowHerdFieldData::NoGround)
+                {
+                    Ground = UCowHerdFieldData::NoGround;
+                    continue;
+                }
+
+                // Too steep to stand on: a wall face, or a slope cows can't climb. With nothing walkable
+                // underneath the steep surface's own height is kept, so it reads as a wall and not a hole.
+                if (!Column.bTopWalkable)
+                {
+                    OutObstacles[Cell] = true;
+                    Ground = Column.BelowHeight != UCowHerdFieldData::NoGround ? Column.BelowHeight : Column.TopHeight;
+                    continue;
+                }
+
+                // A flat top that stands out of the surface beside it, with floor under it, is something standing
+                // on the floor. A mesa of terrain has nothing under it and stays ground, its edge is a cliff.
+                bool bObstacleTop = false;
+                if (Column.BelowHeight != UCowHerdFieldData::NoGround)
+                {
+                    const FIntPoint Neighbors[] = { { X - 1, Y }, { X + 1, Y }, { X, Y - 1 }, { X, Y + 1 } };
+                    for (const FIntPoint& Neighbor : Neighbors)
+                    {
+                        if (Neighbor.X < 0 || Neighbor.Y < 0 || Neighbor.X >= Field.SizeX || Neighbor.Y >= Field.SizeY)
+                            continue;
+
+                        const float NeighborHeight = Columns[Field.GetCellIndex(Neighbor.X, Neighbor.Y)].TopHeight;
+                        if (NeighborHeight != UCowHerdFieldData::NoGround && Column.TopHeight - NeighborHeight > MaxStepHeight)
+                        {
+                            bObstacleTop = true;
+                            break;
+                        }
+                    }
+                }
+
+                OutObstacles[Cell] = bObstacleTop;
+                Ground = bObstacleTop ? Column.BelowHeight : Column.TopHeight;
+            }
+        }
+    }
+
+    void BakeCliffDistances(UCowHerdFieldData& Field, float CliffDropHeight)
+    {
+        const int32 NumCells = Field.SizeX * Field.SizeY;
+
+        // Seed the distance transform: holes and points next to a drop are edges
+        const float MaxDistance = float(TNumericLimits<uint16>::Max());
+        TArray<float> Distances;
+        Distances.Init(MaxDistance, NumCells);
+
+        for (int32 Y = 0; Y < Field.SizeY; ++Y)
+        {
+            for (int32 X = 0; X < Field.SizeX; ++X)
+            {
+                const int32 Cell = Field.GetCellIndex(X, Y);
+                const float Height = Field.GroundHeights[Cell];
+                bool bIsEdge = Height == UCowHerdFieldData::NoGround;
+
+                const FIntPoint Neighbors[] = { { X + 1, Y }, { X, Y + 1 } };
+                for (const FIntPoint& Neighbor : Neighbors)
+                {
+                    if (bIsEdge || Neighbor.X >= Field.SizeX || Neighbor.Y >= Field.SizeY)
+                        continue;
+
+                    const float NeighborHeight = Field.GroundHeights[Field.GetCellIndex(Neighbor.X, Neighbor.Y)];
+                    if (NeighborHeight != UCowHerdFieldData::NoGround && FMath::Abs(NeighborHeight - Height) > CliffDropHeight)
+                    {
+                        // The upper side of a drop is where a cow would fall from
+                        const int32 Upper = NeighborHeight > Height ? Field.GetCellIndex(Neighbor.X, Neighbor.Y) : Cell;
+                        Distances[Upper] = 0.0f;
+                    }
+                }
+
+                if (bIsEdge)
+                {
+                    Distances[Cell] = 0.0f;
+                }
+            }
+        }
+
+        ComputeDistanceTransform(Field, Distances);
+
+        Field.CliffDistances.SetNumUninitialized(NumCells);
+        for (int32 Cell = 0; Cell < NumCells; ++Cell)
+        {
+            Field.CliffDistances[Cell] = uint16(FMath::Min(Distances[Cell], MaxDistance));
+        }
+    }
+
+    void BakeWallDistances(UCowHerdFieldData& Field, const TArray<bool>& Blocked)
+    {
+        const int32 NumCells = Field.SizeX * Field.SizeY;
+        check(Blocked.Num() == NumCells);
+
+        // Distance to the nearest blocked point outside walls, and to the nearest free point inside them
+        const float MaxDistance = float(TNumericLimits<int16>::Max());
+        TArray<float> Outside;
+        TArray<float> Inside;
+        Outside.SetNumUninitialized(NumCells);
+        Inside.SetNumUninitialized(NumCells);
+
+        for (int32 Cell = 0; Cell < NumCells; ++Cell)
+        {
+            Outside[Cell] = Blocked[Cell] ? 0.0f : MaxDistance;
+            Inside[Cell] = Blocked[Cell] ? MaxDistance : 0.0f;
+        }
+
+        ComputeDistanceTransform(Field, Outside);
+        ComputeDistanceTransform(Field, Inside);
+
+        // The wall surface sits halfway between a blocked point and its free neighbor
+        const float HalfCell = Field.CellSize * 0.5f;
+        Field.WallDistances.SetNumUninitialized(NumCells);
+        for (int32 Cell = 0; Cell < NumCells; ++Cell)
+        {
+            const float Distance = Blocked[Cell] ? -(Inside[Cell] - HalfCell) : Outside[Cell] - HalfCell;
+            Field.WallDistances[Cell] = int16(FMath::Clamp(Distance, -MaxDistance, MaxDistance));
+        }
+    }
+}
+
+#endif
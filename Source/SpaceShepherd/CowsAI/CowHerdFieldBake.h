@@ -0,0 +1,40 @@
+// CowHerdFieldBake.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CowHerdFieldData.h"
+
+#if WITH_EDITOR
+
+// What the bake's downward traces found over one grid point
+struct FCowHerdFieldColumn
+{
+    // Topmost static surface, and whether its slope is one a cow can stand on
+    float TopHeight = UCowHerdFieldData::NoGround;
+    bool bTopWalkable = false;
+
+    // Highest walkable surface under the top one, NoGround when there is none
+    float BelowHeight = UCowHerdFieldData::NoGround;
+};
+
+/**
+ *  Grid passes of ACowHerdFieldVolume's bake, kept apart from its traces so they can be checked without a level.
+ */
+namespace CowHerdFieldBake
+{
+    // Picks the ground under every point and flags the points that are obstacles rather than ground: steep surfaces,
+    // and tops more than MaxStepHeight above a neighbor with another surface underneath, such as walls and crates.
+    // Obstacles take the surface below them as their ground, so their tops never show up as ledges in the cliff field.
+    void BakeGround(UCowHerdFieldData& Field, TConstArrayView<FCowHerdFieldColumn> Columns, float MaxStepHeight, TArray<bool>& OutObstacles);
+
+    // Distance from every point to the nearest hole or drop higher than CliffDropHeight
+    void BakeCliffDistances(UCowHerdFieldData& Field, float CliffDropHeight);
+
+    // Signed distance from every point to the surface of the blocked points, negative inside them
+    void BakeWallDistances(UCowHerdFieldData& Field, const TArray<bool>& Blocked);
+
+    // Two pass chamfer distance transform: points seeded with 0 spread their distance over the grid
+    void ComputeDistanceTransform(const UCowHerdFieldData& Field, TArray<float>& Distances);
+}
+
+#endif
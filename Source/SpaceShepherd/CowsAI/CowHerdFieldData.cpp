@@ -0,0 +1,127 @@
+// CowHerdFieldData.cpp
+#include "CowHerdFieldData.h"
+
+bool UCowHerdFieldData::IsValidField() const
+{
+    const int32 NumCells = SizeX * SizeY;
+    return SizeX > 1 && SizeY > 1 && CellSize > 0.0f
+        && GroundHeights.Num() == NumCells
+        && CliffDistances.Num() == NumCells;
+}
+
+bool UCowHerdFieldData::ContainsPoint(const FVector2D& Location) const
+{
+    int32 X, Y;
+    float AlphaX, AlphaY;
+    return GetBilinear(Location, X, Y, AlphaX, AlphaY);
+}
+
+bool UCowHerdFieldData::GetBilinear(const FVector2D& Location, int32& OutX, int32& OutY, float& OutAlphaX, float& OutAlphaY) const
+{
+    const float GridX = (Location.X - Origin.X) / CellSize;
+    const float GridY = (Location.Y - Origin.Y) / CellSize;
+
+    // The last row and column only serve as the far corners of the cells before them
+    if (GridX < 0.0f || GridY < 0.0f || GridX >= SizeX - 1 || GridY >= SizeY - 1)
+        return false;
+
+    OutX = FMath::FloorToInt32(GridX);
+    OutY = FMath::FloorToInt32(GridY);
+    OutAlphaX = GridX - OutX;
+    OutAlphaY = GridY - OutY;
+    return true;
+}
+
+bool UCowHerdFieldData::SampleGround(const FVector2D& Location, bool& bOutHasGround, float& OutHeight) const
+{
+    int32 X, Y;
+    float AlphaX, AlphaY;
+    if (!GetBilinear(Location, X, Y, AlphaX, AlphaY))
+        return false;
+
+    const int32 Corners[4] = {
+        GetCellIndex(X, Y),
+        GetCellIndex(X + 1, Y),
+        GetCellIndex(X, Y + 1),
+        GetCellIndex(X + 1, Y + 1)
+    };
+    const float Weights[4] = {
+        (1.0f - AlphaX) * (1.0f - AlphaY),
+        AlphaX * (1.0f - AlphaY),
+        (1.0f - AlphaX) * AlphaY,
+        AlphaX * AlphaY
+    };
+
+    float GroundWeight = 0.0f;
+    float HeightSum = 0.0f;
+    for (int32 Corner = 0; Corner < 4; ++Corner)
+    {
+        const float Height = GroundHeights[Corners[Corner]];
+        if (Height != NoGround)
+        {
+            GroundWeight += Weights[Corner];
+            HeightSum += Height * Weights[Corner];
+        }
+    }
+
+    bOutHasGround = GroundWeight >= 0.5f;
+    OutHeight = bOutHasGround ? HeightSum / GroundWeight : NoGround;
+    return true;
+}
+
+bool UCowHerdFieldData::SampleCliffDistance(const FVector2D& Location, float& OutDistance) const
+{
+    int32 X, Y;
+    float AlphaX, AlphaY;
+    if (!GetBilinear(Location, X, Y, AlphaX, AlphaY))
+        return false;
+
+    const float Bottom = FMath::Lerp(float(CliffDistances[GetCellIndex(X, Y)]), float(CliffDistances[GetCellIndex(X + 1, Y)]), AlphaX);
+    const float Top = FMath::Lerp(float(CliffDistances[GetCellIndex(X, Y + 1)]), float(CliffDistances[GetCellIndex(X + 1, Y + 1)]), AlphaX);
+    OutDistance = FMath::Lerp(Bottom, Top, AlphaY);
+    return true;
+}
+
+bool UCowHerdFieldData::SampleCliffDistance(const FVector2D& Location, float& OutDistance, FVector2D& OutGradient) const
+{
+    int32 X, Y;
+    float AlphaX, AlphaY;
+    if (!GetBilinear(Location, X, Y, AlphaX, AlphaY))
+        return false;
+
+    const float D00 = CliffDistances[GetCellIndex(X, Y)];
+    const float D10 = CliffDistances[GetCellIndex(X + 1, Y)];
+    const float D01 = CliffDistances[GetCellIndex(X, Y + 1)];
+    const float D11 = CliffDistances[GetCellIndex(X + 1, Y + 1)];
+
+    OutDistance = FMath::Lerp(FMath::Lerp(D00, D10, AlphaX), FMath::Lerp(D01, D11, AlphaX), AlphaY);
+
+    // Analytic gradient of the bilinear patch
+    const FVector2D Gradient(
+        FMath::Lerp(D10 - D00, D11 - D01, AlphaY),
+        FMath::Lerp(D01 - D00, D11 - D10, AlphaX));
+    OutGradient = Gradient.GetSafeNormal();
+    return true;
+}
+
+bool UCowHerdFieldData::SampleWallDistance(const FVector2D& Location, float& OutDistance, FVector2D& OutGradient) const
+{
+    int32 X, Y;
+    float AlphaX, AlphaY;
+    if (!HasWallField() || !GetBilinear(Location, X, Y, AlphaX, AlphaY))
+        return false;
+
+    const float D00 = WallDistances[GetCellIndex(X, Y)];
+    const float D10 = WallDistances[GetCellIndex(X + 1, Y)];
+    const float D01 = WallDistances[GetCellIndex(X, Y + 1)];
+    const float D11 = WallDistances[GetCellIndex(X + 1, Y + 1)];
+
+    OutDistance = FMath::Lerp(FMath::Lerp(D00, D10, AlphaX), FMath::Lerp(D01, D11, AlphaX), AlphaY);
+
+    // Analytic gradient of the bilinear patch
+    const FVector2D Gradient(
+        FMath::Lerp(D10 - D00, D11 - D01, AlphaY),
+        FMath::Lerp(D01 - D00, D11 - D10, AlphaX));
+    OutGradient = Gradient.GetSafeNormal();
+    return true;
+}
@@ -0,0 +1,72 @@
+// CowHerdFieldData.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CowHerdFieldData.generated.h"
+
+/**
+ *  Static sensing data for the herd, baked from level geometry by ACowHerdFieldVolume.
+ *  Values are stored on a regular 2D grid of points starting at Origin and sampled bilinearly,
+ *  so a lookup costs the same no matter how detailed the level is.
+ */
+UCLASS(BlueprintType)
+class UCowHerdFieldData : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    // ========== Grid ==========
+
+    // World XY of grid point (0, 0)
+    UPROPERTY(VisibleAnywhere, Category = "Herd Field")
+    FVector2D Origin = FVector2D::ZeroVector;
+
+    UPROPERTY(VisibleAnywhere, Category = "Herd Field")
+    float CellSize = 100.0f;
+
+    UPROPERTY(VisibleAnywhere, Category = "Herd Field")
+    int32 SizeX = 0;
+
+    UPROPERTY(VisibleAnywhere, Category = "Herd Field")
+    int32 SizeY = 0;
+
+    // ========== Ground ==========
+
+    // Surface cows walk on at each point, the floor under walls and crates; NoGround where the bake found nothing
+    UPROPERTY()
+    TArray<float> GroundHeights;
+
+    // Horizontal distance from each point to the nearest hole or drop, in whole units
+    UPROPERTY()
+    TArray<uint16> CliffDistances;
+
+    // ========== Walls ==========
+
+    // Signed distance from each point to static obstacles at cow height, negative inside them, in whole units.
+    // Empty for fields baked before walls were added.
+    UPROPERTY()
+    TArray<int16> WallDistances;
+
+    static constexpr float NoGround = -UE_BIG_NUMBER;
+
+    bool IsValidField() const;
+    bool HasWallField() const { return WallDistances.Num() == SizeX * SizeY; }
+    bool ContainsPoint(const FVector2D& Location) const;
+
+    // Lookups return false outside the baked bounds, where the caller should fall back to traces.
+    // A point counts as ground when most of its bilinear footprint is; the height blends the ground corners only.
+    bool SampleGround(const FVector2D& Location, bool& bOutHasGround, float& OutHeight) const;
+    bool SampleCliffDistance(const FVector2D& Location, float& OutDistance) const;
+
+    // Cliff distance and its gradient, which points away from the nearest edge (zero on flat plateaus)
+    bool SampleCliffDistance(const FVector2D& Location, float& OutDistance, FVector2D& OutGradient) const;
+
+    // Wall distance and its gradient, which points away from the nearest wall (zero on flat plateaus)
+    bool SampleWallDistance(const FVector2D& Location, float& OutDistance, FVector2D& OutGradient) const;
+
+    int32 GetCellIndex(int32 X, int32 Y) const { return Y * SizeX + X; }
+
+private:
+    bool GetBilinear(const FVector2D& Location, int32& OutX, int32& OutY, float& OutAlphaX, float& OutAlphaY) const;
+};
@@ -0,0 +1,168 @@
+// CowHerdFieldVolume.cpp
+#include "CowHerdFieldVolume.h"
+#include "CowHerdFieldData.h"
+#include "CowHerdFieldBake.h"
+#include "CowHerdSubsystem.h"
+#include "Components/BoxComponent.h"
+#include "Engine/World.h"
+
+ACowHerdFieldVolume::ACowHerdFieldVolume()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    // The box only shows the baked area, it never collides
+    FieldBounds = CreateDefaultSubobject<UBoxComponent>(TEXT("FieldBounds"));
+    RootComponent = FieldBounds;
+    FieldBounds->SetBoxExtent(VolumeSize);
+    FieldBounds->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    FieldBounds->ShapeColor = FColor::Orange;
+    FieldBounds->SetLineThickness(2.0f);
+}
+
+void ACowHerdFieldVolume::OnConstruction(const FTransform& Transform)
+{
+    Super::OnConstruction(Transform);
+
+    // Update volume size when changed in editor
+    if (FieldBounds)
+    {
+        FieldBounds->SetBoxExtent(VolumeSize);
+    }
+}
+
+void ACowHerdFieldVolume::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (!HerdField || !HerdField->IsValidField())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CowHerdFieldVolume: %s has no baked field, cows will use traces"), *GetName());
+        return;
+    }
+
+    if (UCowHerdSubsystem* HerdSubsystem = GetWorld()->GetSubsystem<UCowHerdSubsystem>())
+    {
+        HerdSubsystem->RegisterHerdField(HerdField);
+    }
+}
+
+void ACowHerdFieldVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UCowHerdSubsystem* HerdSubsystem = GetWorld()->GetSubsystem<UCowHerdSubsystem>())
+    {
+        HerdSubsystem->UnregisterHerdField(HerdField);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+#if WITH_EDITOR
+
+void ACowHerdFieldVolume::BakeFields()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+        return;
+
+    Modify();
+    if (!HerdField)
+    {
+        HerdField = NewObject<UCowHerdFieldData>(this, NAME_None, RF_Transactional);
+    }
+    HerdField->Modify();
+
+    const FBox Bounds = FBox::BuildAABB(GetActorLocation(), VolumeSize);
+
+    HerdField->Origin = FVector2D(Bounds.Min);
+    HerdField->CellSize = CellSize;
+    HerdField->SizeX = FMath::CeilToInt32((Bounds.Max.X - Bounds.Min.X) / CellSize) + 1;
+    HerdField->SizeY = FMath::CeilToInt32((Bounds.Max.Y - Bounds.Min.Y) / CellSize) + 1;
+
+    TArray<bool> Obstacles;
+    BakeGround(*HerdField, Bounds, Obstacles);
+    BakeWalls(*HerdField, Obstacles);
+
+    HerdField->MarkPackageDirty();
+
+    UE_LOG(LogTemp, Log, TEXT("CowHerdFieldVolume: baked %dx%d field for %s"), HerdField->SizeX, HerdField->SizeY, *GetName());
+}
+
+void ACowHerdFieldVolume::BakeGround(UCowHerdFieldData& Field, const FBox& Bounds, TArray<bool>& OutObstacles) const
+{
+    TArray<FCowHerdFieldColumn> Columns;
+    Columns.SetNum(Field.SizeX * Field.SizeY);
+
+    // Only static geometry is baked; cows and other movers are not part of the terrain.
+    // Every surface along the way is kept so the ground under walls and crates can be told from their tops.
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CowHerdFieldBake), false, this);
+    const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+    const float WalkableFloorZ = FMath::Cos(FMath::DegreesToRadians(WalkableFloorAngle));
+    TArray<FHitResult> Hits;
+
+    for (int32 Y = 0; Y < Field.SizeY; ++Y)
+    {
+        for (int32 X = 0; X < Field.SizeX; ++X)
+        {
+            const FVector2D Point = Field.Origin + FVector2D(X, Y) * Field.CellSize;
+            const FVector Start(Point, Bounds.Max.Z);
+            const FVector End(Point, Bounds.Min.Z);
+
+            // Object queries report every surface the ray crosses, nearest first
+            Hits.Reset();
+            GetWorld()->LineTraceMultiByObjectType(Hits, Start, End, ObjectParams, QueryParams);
+            if (Hits.Num() == 0)
+                continue;
+
+            FCowHerdFieldColumn& Column = Columns[Field.GetCellIndex(X, Y)];
+            Column.TopHeight = float(Hits[0].ImpactPoint.Z);
+            Column.bTopWalkable = Hits[0].ImpactNormal.Z >= WalkableFloorZ;
+
+            for (int32 HitIndex = 1; HitIndex < Hits.Num(); ++HitIndex)
+            {
+                if (Hits[HitIndex].ImpactNormal.Z >= WalkableFloorZ && Hits[HitIndex].ImpactPoint.Z < Column.TopHeight)
+                {
+                    Column.BelowHeight = float(Hits[HitIndex].ImpactPoint.Z);
+                    break;
+                }
+            }
+        }
+    }
+
+    CowHerdFieldBake::BakeGround(Field, Columns, MaxStepHeight, OutObstacles);
+    CowHerdFieldBake::BakeCliffDistances(Field, CliffDropHeight);
+}
+
+void ACowHerdFieldVolume::BakeWalls(UCowHerdFieldData& Field, const TArray<bool>& Obstacles) const
+{
+    const int32 NumCells = Field.SizeX * Field.SizeY;
+
+    // Points the ground bake found standing on an obstacle are inside it. The rest are probed where the cow
+    // feelers run, a small sphere above the ground, which catches walls thinner than a cell and overhangs.
+    // Keep it clear of the ground itself so slopes don't read as walls.
+    const float ProbeRadius = FMath::Min(Field.CellSize * 0.5f, WallProbeHeight * 0.4f);
+    const FCollisionShape ProbeShape = FCollisionShape::MakeSphere(ProbeRadius);
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CowHerdFieldBake), false, this);
+    const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+
+    TArray<bool> Blocked = Obstacles;
+
+    for (int32 Y = 0; Y < Field.SizeY; ++Y)
+    {
+        for (int32 X = 0; X < Field.SizeX; ++X)
+        {
+            const int32 Cell = Field.GetCellIndex(X, Y);
+            const float Height = Field.GroundHeights[Cell];
+
+            // Holes belong to the cliff field, not the wall field
+            if (Blocked[Cell] || Height == UCowHerdFieldData::NoGround)
+                continue;
+
+            const FVector Point(Field.Origin + FVector2D(X, Y) * Field.CellSize, Height + WallProbeHeight);
+            Blocked[Cell] = GetWorld()->OverlapAnyTestByObjectType(Point, FQuat::Identity, ObjectParams, ProbeShape, QueryParams);
+        }
+    }
+
+    CowHerdFieldBake::BakeWallDistances(Field, Blocked);
+}
+
+#endif
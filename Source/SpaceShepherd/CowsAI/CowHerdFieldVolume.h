@@ -0,0 +1,70 @@
+// CowHerdFieldVolume.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "CowHerdFieldVolume.generated.h"
+
+class UCowHerdFieldData;
+
+/**
+ *  Marks the part of a level the herd roams in and bakes its static sensing fields.
+ *  Place one over the pasture, hit Bake Fields in the details panel and save the level.
+ *  At runtime the volume hands its field to the herd subsystem; cows outside it fall back to traces.
+ */
+UCLASS()
+class ACowHerdFieldVolume : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    ACowHerdFieldVolume();
+
+    // Half size of the baked area; the volume is axis aligned, rotation is ignored
+    UPROPERTY(EditAnywhere, Category = "Herd Field")
+    FVector VolumeSize = FVector(5000.0f, 5000.0f, 1000.0f);
+
+    // Spacing of the baked grid
+    UPROPERTY(EditAnywhere, Category = "Herd Field", meta = (ClampMin = "10.0"))
+    float CellSize = 100.0f;
+
+    // Height change between neighboring points that counts as a drop rather than a slope
+    UPROPERTY(EditAnywhere, Category = "Herd Field", meta = (ClampMin = "0.0"))
+    float CliffDropHeight = 150.0f;
+
+    // Tallest rise a cow walks up, as on its CharacterMovement; anything standing taller out of the floor is an obstacle
+    UPROPERTY(EditAnywhere, Category = "Herd Field", meta = (ClampMin = "0.0"))
+    float MaxStepHeight = 45.0f;
+
+    // Steepest surface a cow stands on, as on its CharacterMovement; steeper ones are obstacles, never ground
+    UPROPERTY(EditAnywhere, Category = "Herd Field", meta = (ClampMin = "0.0", ClampMax = "90.0"))
+    float WalkableFloorAngle = 44.765f;
+
+    // Height above the ground at which static obstacles count as walls, where the cows' wall feelers run
+    UPROPERTY(EditAnywhere, Category = "Herd Field", meta = (ClampMin = "10.0"))
+    float WallProbeHeight = 100.0f;
+
+    // Baked result. Bake creates one inside the level when none is assigned.
+    UPROPERTY(EditAnywhere, Category = "Herd Field")
+    UCowHerdFieldData* HerdField = nullptr;
+
+#if WITH_EDITOR
+    // Rasterize the static geometry inside the volume into HerdField
+    UFUNCTION(CallInEditor, Category = "Herd Field")
+    void BakeFields();
+#endif
+
+protected:
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void OnConstruction(const FTransform& Transform) override;
+
+private:
+    UPROPERTY(VisibleAnywhere, Category = "Components")
+    class UBoxComponent* FieldBounds;
+
+#if WITH_EDITOR
+    void BakeGround(UCowHerdFieldData& Field, const FBox& Bounds, TArray<bool>& OutObstacles) const;
+    void BakeWalls(UCowHerdFieldData& Field, const TArray<bool>& Obstacles) const;
+#endif
+};
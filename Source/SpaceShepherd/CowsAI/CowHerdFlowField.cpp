@@ -0,0 +1,221 @@
+// CowHerdFlowField.cpp
+#include "CowHerdFlowField.h"
+#include "CowHerdFieldData.h"
+
+static constexpr float UnreachableDistance = TNumericLimits<float>::Max();
+
+void FCowHerdFlowField::BeginBuild(const UCowHerdFieldData& Field, TConstArrayView<FBox> Goals, TConstArrayView<FVector4> Blockers, float Clearance)
+{
+    PendingField = &Field;
+    PendingGoals.Reset();
+    PendingGoals.Append(Goals.GetData(), Goals.Num());
+    PendingBlockers.Reset();
+    PendingBlockers.Append(Blockers.GetData(), Blockers.Num());
+    PendingClearance = Clearance;
+    NumPreparedRows = 0;
+
+    PendingOrigin = Field.Origin;
+    PendingCellSize = Field.CellSize;
+    PendingSizeX = Field.SizeX;
+    PendingSizeY = Field.SizeY;
+
+    const int32 NumCells = PendingSizeX * PendingSizeY;
+    Walkable.SetNumUninitialized(NumCells);
+    PendingDistances.Init(UnreachableDistance, NumCells);
+    OpenList.Reset();
+
+    bBuilding = true;
+}
+
+void FCowHerdFlowField::PrepareRow(int32 Y)
+{
+    const UCowHerdFieldData& Field = *PendingField;
+    const bool bHasWalls = Field.HasWallField();
+    const float PointY = PendingOrigin.Y + Y * PendingCellSize;
+
+    for (int32 X = 0; X < PendingSizeX; ++X)
+    {
+        const int32 Cell = Field.GetCellIndex(X, Y);
+        Walkable[Cell] = Field.GroundHeights[Cell] != UCowHerdFieldData::NoGround
+            && (!bHasWalls || Field.WallDistances[Cell] > PendingClearance);
+    }
+
+    // Each blocker closes the stretch of the row inside its circle grown by the clearance,
+    // so the cost per row is one chord per blocker rather than every blocker for every point
+    for (const FVector4& Circle : PendingBlockers)
+    {
+        const float Radius = Circle.W + PendingClearance;
+        const float OffsetY = PointY - Circle.Y;
+        if (FMath::Abs(OffsetY) > Radius)
+            continue;
+
+        const float HalfChord = FMath::Sqrt(FMath::Max(FMath::Square(Radius) - FMath::Square(OffsetY), 0.0f));
+        const int32 MinX = FMath::Max(FMath::CeilToInt32((Circle.X - HalfChord - PendingOrigin.X) / PendingCellSize), 0);
+        const int32 MaxX = FMath::Min(FMath::FloorToInt32((Circle.X + HalfChord - PendingOrigin.X) / PendingCellSize), PendingSizeX - 1);
+        for (int32 X = MinX; X <= MaxX; ++X)
+        {
+            Walkable[Y * PendingSizeX + X] = false;
+        }
+    }
+
+    // Pen points seed the search, walkable or not, so a pen with a fence around it still pulls
+    for (const FBox& Goal : PendingGoals)
+    {
+        if (PointY < Goal.Min.Y || PointY > Goal.Max.Y)
+            continue;
+
+        const int32 MinX = FMath::Max(FMath::CeilToInt32((Goal.Min.X - PendingOrigin.X) / PendingCellSize), 0);
+        const int32 MaxX = FMath::Min(FMath::FloorToInt32((Goal.Max.X - PendingOrigin.X) / PendingCellSize), PendingSizeX - 1);
+        for (int32 X = MinX; X <= MaxX; ++X)
+        {
+            const int32 Cell = Y * PendingSizeX + X;
+            Walkable[Cell] = true;
+            if (PendingDistances[Cell] != 0.0f)
+            {
+                PendingDistances[Cell] = 0.0f;
+                OpenList.HeapPush({ 0.0f, Cell });
+            }
+        }
+    }
+}
+
+bool FCowHerdFlowField::StepBuild(int32 MaxCells)
+{
+    if (!bBuilding)
+        return false;
+
+    // Sort out which points are walkable first, a row at a time out of the same budget as the search
+    int32 Budget = MaxCells;
+    while (NumPreparedRows < PendingSizeY && Budget > 0)
+    {
+        PrepareRow(NumPreparedRows++);
+        Budget -= PendingSizeX;
+    }
+
+    if (NumPreparedRows < PendingSizeY)
+        return false;
+
+    const float Straight = PendingCellSize;
+    const float Diagonal = PendingCellSize * UE_SQRT_2;
+
+    static const FIntPoint Offsets[] = {
+        { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+        { 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 }
+    };
+
+    auto IsWalkable = [this](int32 X, int32 Y)
+    {
+        return X >= 0 && Y >= 0 && X < PendingSizeX && Y < PendingSizeY && Walkable[Y * PendingSizeX + X];
+    };
+
+    int32 NumSettled = 0;
+    while (OpenList.Num() > 0 && NumSettled < Budget)
+    {
+        FHeapEntry Entry;
+        OpenList.HeapPop(Entry, EAllowShrinking::No);
+
+        // Stale entry, the point was reached by a shorter path since it was queued
+        if (Entry.Distance > PendingDistances[Entry.Cell])
+            continue;
+
+        ++NumSettled;
+        const int32 X = Entry.Cell % PendingSizeX;
+        const int32 Y = Entry.Cell / PendingSizeX;
+
+        for (int32 Direction = 0; Direction < UE_ARRAY_COUNT(Offsets); ++Direction)
+        {
+            const FIntPoint& Offset = Offsets[Direction];
+            const int32 NeighborX = X + Offset.X;
+            const int32 NeighborY = Y + Offset.Y;
+            if (!IsWalkable(NeighborX, NeighborY))
+                continue;
+
+            // No cutting corners past a wall
+            const bool bIsDiagonal = Direction >= 4;
+            if (bIsDiagonal && (!IsWalkable(X + Offset.X, Y) || !IsWalkable(X, Y + Offset.Y)))
+                continue;
+
+            const int32 Neighbor = NeighborY * PendingSizeX + NeighborX;
+            const float Distance = Entry.Distance + (bIsDiagonal ? Diagonal : Straight);
+            if (Distance < PendingDistances[Neighbor])
+            {
+                PendingDistances[Neighbor] = Distance;
+                OpenList.HeapPush({ Distance, Neighbor });
+            }
+        }
+    }
+
+    if (OpenList.Num() > 0)
+        return false;
+
+    // Done, swap the new field in
+    Origin = PendingOrigin;
+    CellSize = PendingCellSize;
+    SizeX = PendingSizeX;
+    SizeY = PendingSizeY;
+    Swap(Distances, PendingDistances);
+    bBuilding = false;
+    PendingField = nullptr;
+    return true;
+}
+
+bool FCowHerdFlowField::Sample(const FVector2D& Location, FVector2D& OutDirection, float& OutDistance) const
+{
+    if (!IsValid())
+        return false;
+
+    const float GridX = (Location.X - Origin.X) / CellSize;
+    const float GridY = (Location.Y - Origin.Y) / CellSize;
+    const int32 X = FMath::FloorToInt32(GridX);
+    const int32 Y = FMath::FloorToInt32(GridY);
+    if (!IsInside(X, Y) || !IsInside(X + 1, Y + 1))
+        return false;
+
+    const float D00 = Distances[GetCellIndex(X, Y)];
+    const float D10 = Distances[GetCellIndex(X + 1, Y)];
+    const float D01 = Distances[GetCellIndex(X, Y + 1)];
+    const float D11 = Distances[GetCellIndex(X + 1, Y + 1)];
+    const float AlphaX = GridX - X;
+    const float AlphaY = GridY - Y;
+
+    // Open ground: follow the bilinear slope downhill
+    if (D00 != UnreachableDistance && D10 != UnreachableDistance && D01 != UnreachableDistance && D11 != UnreachableDistance)
+    {
+        OutDistance = FMath::Lerp(FMath::Lerp(D00, D10, AlphaX), FMath::Lerp(D01, D11, AlphaX), AlphaY);
+        const FVector2D Gradient(
+            FMath::Lerp(D10 - D00, D11 - D01, AlphaY),
+            FMath::Lerp(D01 - D00, D11 - D10, AlphaX));
+        OutDirection = (-Gradient).GetSafeNormal();
+        return !OutDirection.IsZero() || OutDistance <= 0.0f;
+    }
+
+    // Next to a wall: head for the lowest neighbor of the closest walkable point
+    const int32 NearestX = FMath::RoundToInt32(GridX);
+    const int32 NearestY = FMath::RoundToInt32(GridY);
+    const float NearestDistance = Distances[GetCellIndex(NearestX, NearestY)];
+    if (NearestDistance == UnreachableDistance)
+        return false;
+
+    FIntPoint Best(NearestX, NearestY);
+    float BestDistance = NearestDistance;
+    for (int32 OffsetY = -1; OffsetY <= 1; ++OffsetY)
+    {
+        for (int32 OffsetX = -1; OffsetX <= 1; ++OffsetX)
+        {
+            if (!IsInside(NearestX + OffsetX, NearestY + OffsetY))
+                continue;
+
+            const float Distance = Distances[GetCellIndex(NearestX + OffsetX, NearestY + OffsetY)];
+            if (Distance < BestDistance)
+            {
+                BestDistance = Distance;
+                Best = FIntPoint(NearestX + OffsetX, NearestY + OffsetY);
+            }
+        }
+    }
+
+    const FVector2D BestPoint = Origin + FVector2D(Best) * CellSize;
+    OutDirection = (BestPoint - Location).GetSafeNormal();
+    OutDistance = NearestDistance;
+    return true;
+}
@@ -0,0 +1,67 @@
+// CowHerdFlowField.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UCowHerdFieldData;
+
+/**
+ *  Shared path-distance field toward the pens over one baked herd field.
+ *  A multi-source Dijkstra from every pen point fills in the walking distance to the closest pen,
+ *  and cows read their way home from its slope. Rebuilds, both sorting out the walkable points and the search,
+ *  are spread over several ticks and the previous result keeps serving samples until the new one is complete.
+ */
+class FCowHerdFlowField
+{
+public:
+    // Start over on the given field. Points that lack ground, sit closer than Clearance to a wall,
+    // or fall inside a blocker circle (XY center, radius in W) are not walkable. Goals are the pen boxes.
+    void BeginBuild(const UCowHerdFieldData& Field, TConstArrayView<FBox> Goals, TConstArrayView<FVector4> Blockers, float Clearance);
+
+    // Classify or settle up to MaxCells points of the pending build; true when this call finished it
+    bool StepBuild(int32 MaxCells);
+
+    bool IsBuilding() const { return bBuilding; }
+    bool IsValid() const { return Distances.Num() > 0; }
+
+    // Unit direction toward the nearest pen and the remaining walking distance.
+    // False outside the field or where no pen can be reached.
+    bool Sample(const FVector2D& Location, FVector2D& OutDirection, float& OutDistance) const;
+
+private:
+    struct FHeapEntry
+    {
+        float Distance;
+        int32 Cell;
+
+        bool operator<(const FHeapEntry& Other) const { return Distance < Other.Distance; }
+    };
+
+    bool IsInside(int32 X, int32 Y) const { return X >= 0 && Y >= 0 && X < SizeX && Y < SizeY; }
+    int32 GetCellIndex(int32 X, int32 Y) const { return Y * SizeX + X; }
+
+    // Walkability and pen seeds for one row of the pending build
+    void PrepareRow(int32 Y);
+
+    // Completed field
+    FVector2D Origin = FVector2D::ZeroVector;
+    float CellSize = 100.0f;
+    int32 SizeX = 0;
+    int32 SizeY = 0;
+    TArray<float> Distances;
+
+    // Build in progress. The field outlives it: the subsystem drops a flow field together with its herd field.
+    bool bBuilding = false;
+    const UCowHerdFieldData* PendingField = nullptr;
+    TArray<FBox> PendingGoals;
+    TArray<FVector4> PendingBlockers;
+    float PendingClearance = 0.0f;
+    int32 NumPreparedRows = 0;
+    FVector2D PendingOrigin = FVector2D::ZeroVector;
+    float PendingCellSize = 100.0f;
+    int32 PendingSizeX = 0;
+    int32 PendingSizeY = 0;
+    TArray<float> PendingDistances;
+    TArray<bool> Walkable;
+    TArray<FHeapEntry> OpenList;
+};
@@ -0,0 +1,197 @@
+// CowHerdInfluenceMap.cpp
+#include "CowHerdInfluenceMap.h"
+
+// Sources spread far apart coarsen the grid rather than growing it past this many cells per layer
+static constexpr int32 MaxInfluenceCells = 256 * 256;
+
+// Potential of the cells just past a source's rim, enough to win an empty cell and nothing else
+static constexpr float RimPotential = 1.e-3f;
+
+void FCowHerdInfluenceMap::AddSource(ECowHerdInfluence Layer, const FVector& Location, float Radius)
+{
+    if (Radius <= 0.0f || Layer == ECowHerdInfluence::Num)
+        return;
+
+    Sources.Add({ FVector2D(Location), Radius, Layer });
+}
+
+void FCowHerdInfluenceMap::Build(float InCellSize)
+{
+    NumBuiltSources = Sources.Num();
+    NumStampedCells = 0;
+
+    // Nothing moved since the last build, the grid already holds these sources
+    if (InCellSize == BuiltCellSize && Sources == BuiltSources)
+    {
+        Sources.Reset();
+        return;
+    }
+
+    Swap(Sources, BuiltSources);
+    Sources.Reset();
+    BuiltCellSize = InCellSize;
+
+    if (BuiltSources.Num() == 0)
+    {
+        SizeX = 0;
+        SizeY = 0;
+        Potentials.Reset();
+        Winners.Reset();
+        return;
+    }
+
+    // Span only the sources' footprints
+    FBox2D Bounds(ForceInit);
+    float MinRadius = UE_BIG_NUMBER;
+    for (const FSource& Source : BuiltSources)
+    {
+        Bounds += FBox2D(Source.Location - FVector2D(Source.Radius), Source.Location + FVector2D(Source.Radius));
+        MinRadius = FMath::Min(MinRadius, Source.Radius);
+    }
+
+    const FVector2D Extent = Bounds.GetSize();
+    CellSize = FMath::Max3(InCellSize, 1.0f, float(FMath::Sqrt(Extent.X * Extent.Y / MaxInfluenceCells)));
+    Origin = Bounds.Min;
+    SizeX = FMath::Max(FMath::CeilToInt32(Extent.X / CellSize), 1);
+    SizeY = FMath::Max(FMath::CeilToInt32(Extent.Y / CellSize), 1);
+
+    // A cone needs a couple of cells across its radius to have a slope worth following
+    if (MinRadius < 2.0f * CellSize && !bWarnedCoarseCells)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CowHerdInfluenceMap: %.0f cm cells for a %.0f cm influence radius (sources span %.0f x %.0f cm); cows near it steer coarsely"),
+            CellSize, MinRadius, Extent.X, Extent.Y);
+        bWarnedCoarseCells = true;
+    }
+
+    Potentials.Reset();
+    Potentials.SetNumZeroed(SizeX * SizeY * int32(ECowHerdInfluence::Num));
+    Winners.Reset();
+    Winners.Init(INDEX_NONE, Potentials.Num());
+
+    // Cells reach one cell past the rim with a token potential, so every point inside a radius has a corner
+    // that knows the source; Sample measures the exact distance to it
+    const float RimMargin = CellSize;
+    for (int32 SourceIndex = 0; SourceIndex < BuiltSources.Num(); ++SourceIndex)
+    {
+        const FSource& Source = BuiltSources[SourceIndex];
+        const float Reach = Source.Radius + RimMargin;
+        const FVector2D Min = (Source.Location - FVector2D(Reach) - Origin) / CellSize;
+        const FVector2D Max = (Source.Location + FVector2D(Reach) - Origin) / CellSize;
+        const int32 MinX = FMath::Clamp(FMath::FloorToInt32(Min.X), 0, SizeX - 1);
+        const int32 MinY = FMath::Clamp(FMath::FloorToInt32(Min.Y), 0, SizeY - 1);
+        const int32 MaxX = FMath::Clamp(FMath::FloorToInt32(Max.X), 0, SizeX - 1);
+        const int32 MaxY = FMath::Clamp(FMath::FloorToInt32(Max.Y), 0, SizeY - 1);
+        const float InvRadius = 1.0f / Source.Radius;
+
+        for (int32 Y = MinY; Y <= MaxY; ++Y)
+        {
+            for (int32 X = MinX; X <= MaxX; ++X)
+            {
+                const FVector2D CellCenter = Origin + FVector2D(X + 0.5f, Y + 0.5f) * CellSize;
+                const float Distance = FVector2D::Distance(CellCenter, Source.Location);
+                if (Distance >= Reach)
+                    continue;
+
+                const int32 CellIndex = GetCellIndex(Source.Layer, X, Y);
+                const float SourcePotential = FMath::Max(1.0f - Distance * InvRadius, RimPotential);
+                if (SourcePotential > Potentials[CellIndex])
+                {
+                    Potentials[CellIndex] = SourcePotential;
+                    Winners[CellIndex] = SourceIndex;
+                }
+                ++NumStampedCells;
+            }
+        }
+    }
+}
+
+void FCowHerdInfluenceMap::Reset()
+{
+    Sources.Empty();
+    BuiltSources.Empty();
+    BuiltCellSize = 0.0f;
+    Potentials.Empty();
+    Winners.Empty();
+    SizeX = 0;
+    SizeY = 0;
+    NumBuiltSources = 0;
+    NumStampedCells = 0;
+}
+
+float FCowHerdInfluenceMap::GetPotential(ECowHerdInfluence Layer, int32 X, int32 Y) const
+{
+    if (X < 0 || Y < 0 || X >= SizeX || Y >= SizeY)
+        return 0.0f;
+
+    return Potentials[GetCellIndex(Layer, X, Y)];
+}
+
+void FCowHerdInfluenceMap::Sample(const FVector& Location, FCowHerdInfluence& OutInfluence) const
+{
+    OutInfluence = FCowHerdInfluence();
+    if (IsEmpty())
+        return;
+
+    // Bilinear between the four surrounding cell centers
+    const float FX = float((Location.X - Origin.X) / CellSize) - 0.5f;
+    const float FY = float((Location.Y - Origin.Y) / CellSize) - 0.5f;
+    const int32 X = FMath::FloorToInt32(FX);
+    const int32 Y = FMath::FloorToInt32(FY);
+    if (X < -1 || Y < -1 || X >= SizeX || Y >= SizeY)
+        return;
+
+    const float TX = FX - X;
+    const float TY = FY - Y;
+
+    for (int32 Layer = 0; Layer < int32(ECowHerdInfluence::Num); ++Layer)
+    {
+        const ECowHerdInfluence LayerType = ECowHerdInfluence(Layer);
+        const float V00 = GetPotential(LayerType, X, Y);
+        const float V10 = GetPotential(LayerType, X + 1, Y);
+        const float V01 = GetPotential(LayerType, X, Y + 1);
+        const float V11 = GetPotential(LayerType, X + 1, Y + 1);
+
+        const float Potential = FMath::Lerp(FMath::Lerp(V00, V10, TX), FMath::Lerp(V01, V11, TX), TY);
+        if (Potential <= 0.0f)
+            continue;
+
+        // The source strongest at the nearest corners is the one this point answers to; distance and range are
+        // measured to it exactly, the grid only picks it and gives the slope
+        int32 Winner = INDEX_NONE;
+        float MaxCorner = 0.0f;
+        for (const FIntPoint Corner : { FIntPoint(X, Y), FIntPoint(X + 1, Y), FIntPoint(X, Y + 1), FIntPoint(X + 1, Y + 1) })
+        {
+            const float CornerPotential = GetPotential(LayerType, Corner.X, Corner.Y);
+            if (CornerPotential > MaxCorner)
+            {
+                MaxCorner = CornerPotential;
+                Winner = Winners[GetCellIndex(LayerType, Corner.X, Corner.Y)];
+            }
+        }
+
+        const FSource& Source = BuiltSources[Winner];
+        const FVector2D ToSource = Source.Location - FVector2D(Location);
+        const float Distance = float(ToSource.Size());
+        if (Distance > Source.Radius)
+            continue;
+
+        FCowHerdInfluenceSample& Sample = OutInfluence.Layers[Layer];
+        Sample.bInRange = true;
+        Sample.Distance = Distance;
+        Sample.SourceLocation = Source.Location;
+
+        // Up the slope leads away from every other source of the layer too; where it is flat, head for the winner
+        const FVector2D Gradient = FVector2D(
+            FMath::Lerp(V10 - V00, V11 - V01, TY),
+            FMath::Lerp(V01 - V00, V11 - V10, TX));
+        const float Slope = float(Gradient.Size());
+        if (Slope > UE_KINDA_SMALL_NUMBER)
+        {
+            Sample.Direction = FVector(Gradient / Slope, 0.0f);
+        }
+        else if (Distance > UE_KINDA_SMALL_NUMBER)
+        {
+            Sample.Direction = FVector(ToSource / Distance, 0.0f);
+        }
+    }
+}
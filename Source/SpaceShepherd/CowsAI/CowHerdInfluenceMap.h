@@ -0,0 +1,100 @@
+// CowHerdInfluenceMap.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+// What a source does to the cows in its reach; each kind is its own layer of the map
+enum class ECowHerdInfluence : uint8
+{
+    Attraction,     // Shepherds calling cows in
+    Repulsion,      // Shepherds driving cows off, danger
+    Lure,           // Laser points and bait, followed over everything else
+    Num
+};
+
+// One layer of the map seen from a point
+struct FCowHerdInfluenceSample
+{
+    // Ground-plane direction up the potential's slope, toward the strongest source, zero on the source itself
+    FVector Direction = FVector::ZeroVector;
+
+    // The strongest source in reach and the exact ground-plane distance to it
+    FVector2D SourceLocation = FVector2D::ZeroVector;
+    float Distance = 0.0f;
+    bool bInRange = false;
+
+    // The source at Location's height
+    FVector GetSourceLocation(const FVector& Location) const { return FVector(SourceLocation, Location.Z); }
+};
+
+// Every layer of the map seen from one cow
+struct FCowHerdInfluence
+{
+    FCowHerdInfluenceSample Layers[int32(ECowHerdInfluence::Num)];
+
+    const FCowHerdInfluenceSample& operator[](ECowHerdInfluence Layer) const { return Layers[int32(Layer)]; }
+};
+
+/**
+ *  Coarse 2D grid of influence potentials shared by the whole herd, rebuilt in a herd tick when its sources moved.
+ *  Every source stamps a cone, one at its center falling to zero at its radius, into its layer;
+ *  overlapping sources keep the larger value, so the closest source wins the way a single one would.
+ *  Cows then sample each layer once instead of checking every source, which makes the cost
+ *  sources x stamped cells + cows, however many shepherds, lasers or baits there are.
+ *  Each cell also remembers which source won it, so a sample measures the exact distance to that source
+ *  instead of reading it back from the blended potential.
+ *  The grid only spans the sources' footprints, so an empty map costs nothing.
+ */
+class FCowHerdInfluenceMap
+{
+public:
+    // Queue a source for the next build
+    void AddSource(ECowHerdInfluence Layer, const FVector& Location, float Radius);
+
+    // Stamp every queued source into a fresh grid, unless they match the last build, and clear the queue
+    void Build(float InCellSize);
+
+    // Direction and distance to the strongest source of every layer at Location
+    void Sample(const FVector& Location, FCowHerdInfluence& OutInfluence) const;
+
+    void Reset();
+
+    bool IsEmpty() const { return SizeX == 0; }
+    int32 GetNumSources() const { return NumBuiltSources; }
+    int32 GetNumStampedCells() const { return NumStampedCells; }
+
+private:
+    struct FSource
+    {
+        FVector2D Location;
+        float Radius;
+        ECowHerdInfluence Layer;
+
+        bool operator==(const FSource& Other) const { return Location == Other.Location && Radius == Other.Radius && Layer == Other.Layer; }
+    };
+
+    int32 GetCellIndex(ECowHerdInfluence Layer, int32 X, int32 Y) const { return (int32(Layer) * SizeY + Y) * SizeX + X; }
+    float GetPotential(ECowHerdInfluence Layer, int32 X, int32 Y) const;
+
+    TArray<FSource> Sources;
+
+    // What the grid was last stamped from; a tick with the same sources keeps it
+    TArray<FSource> BuiltSources;
+    float BuiltCellSize = 0.0f;
+
+    // Potentials of every layer, one SizeX * SizeY block per layer, sampled at cell centers
+    FVector2D Origin = FVector2D::ZeroVector;
+    float CellSize = 100.0f;
+    int32 SizeX = 0;
+    int32 SizeY = 0;
+    TArray<float> Potentials;
+
+    // Index into BuiltSources of the source that set each potential, INDEX_NONE where none reaches
+    TArray<int32> Winners;
+
+    int32 NumBuiltSources = 0;
+    int32 NumStampedCells = 0;
+
+    // Reported once, not every build
+    bool bWarnedCoarseCells = false;
+};
@@ -0,0 +1,78 @@
+// CowHerdMass.cpp
+#include "CowHerdMass.h"
+#include "MassActorSubsystem.h"
+#include "MassEntityManager.h"
+#include "MassEntityUtils.h"
+#include "MassCommandBuffer.h"
+#include "Engine/World.h"
+
+namespace CowHerdMass
+{
+    // Cows placed or spawned as plain actors have no entity; those are left alone
+    static FMassEntityHandle FindEntity(const AActor* Cow, FMassEntityManager*& OutEntityManager)
+    {
+        UWorld* World = Cow ? Cow->GetWorld() : nullptr;
+        const UMassActorSubsystem* ActorSubsystem = World ? World->GetSubsystem<UMassActorSubsystem>() : nullptr;
+        if (!ActorSubsystem)
+            return FMassEntityHandle();
+
+        const FMassEntityHandle Entity = ActorSubsystem->GetEntityHandleFromActor(Cow);
+        if (!Entity.IsSet())
+            return FMassEntityHandle();
+
+        OutEntityManager = UE::Mass::Utils::GetEntityManager(World);
+        return OutEntityManager ? Entity : FMassEntityHandle();
+    }
+
+    void DestroyEntityForActor(const AActor* Cow)
+    {
+        FMassEntityManager* EntityManager = nullptr;
+        const FMassEntityHandle Entity = FindEntity(Cow, EntityManager);
+        if (!Entity.IsSet())
+            return;
+
+        // Right away when possible, so pens see the cow gone rather than despawned while its actor is destroyed;
+        // deferred when the actor goes away in the middle of a Mass phase
+        if (EntityManager->IsProcessing())
+        {
+            EntityManager->Defer().DestroyEntity(Entity);
+        }
+        else
+        {
+            EntityManager->DestroyEntity(Entity);
+        }
+    }
+
+    uint64 GetEntityKey(const AActor* Cow)
+    {
+        FMassEntityManager* EntityManager = nullptr;
+        const FMassEntityHandle Entity = FindEntity(Cow, EntityManager);
+        return Entity.IsSet() && EntityManager->IsEntityValid(Entity) ? Entity.AsNumber() : 0;
+    }
+
+    bool IsRepresentationDespawn(const AActor* Cow)
+    {
+        // The representation destroys far actors, or disables their collision when it pools them
+        if (!Cow || (!Cow->IsActorBeingDestroyed() && Cow->GetActorEnableCollision()))
+            return false;
+
+        return GetEntityKey(Cow) != 0;
+    }
+
+    void SetEntityPenned(const AActor* Cow, bool bPenned)
+    {
+        FMassEntityManager* EntityManager = nullptr;
+        const FMassEntityHandle Entity = FindEntity(Cow, EntityManager);
+        if (!Entity.IsSet())
+            return;
+
+        if (bPenned)
+        {
+            EntityManager->Defer().AddTag<FCowHerdMassPennedTag>(Entity);
+        }
+        else
+        {
+            EntityManager->Defer().RemoveTag<FCowHerdMassPennedTag>(Entity);
+        }
+    }
+}
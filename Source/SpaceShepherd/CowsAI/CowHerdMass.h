@@ -0,0 +1,99 @@
+// CowHerdMass.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "CowHerdMass.generated.h"
+
+class AActor;
+
+// Marks entities simulated as herd cows
+USTRUCT()
+struct FCowHerdMassTag : public FMassTag
+{
+    GENERATED_BODY()
+};
+
+// Marks herd entities whose cow is counted in a pen; they hold still there while they have no actor
+USTRUCT()
+struct FCowHerdMassPennedTag : public FMassTag
+{
+    GENERATED_BODY()
+};
+
+// Per-cow boids state for cows living as Mass entities
+USTRUCT()
+struct FCowHerdMassFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    FVector Velocity = FVector::ZeroVector;
+    FVector WanderTarget = FVector::ForwardVector;
+    FRandomStream RandomStream;
+    bool bInitialized = false;
+};
+
+// Boids tuning shared by every cow spawned from one entity config, mirrors UCowBoidsComponent
+USTRUCT()
+struct FCowHerdMassParameters : public FMassConstSharedFragment
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, Category = "Boids|Movement")
+    float WanderSpeed = 150.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Boids|Movement")
+    float MaxSteerForce = 150.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Boids|Movement")
+    float WanderRadius = 100.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Boids|Movement")
+    float WanderDistance = 200.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Boids|Movement")
+    float WanderJitter = 40.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Boids|Avoidance")
+    float SeparationRadius = 150.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Boids|Avoidance")
+    float SeparationWeight = 2.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Boids|Avoidance")
+    float ObstacleAvoidanceWeight = 3.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Boids|Avoidance")
+    float WallAvoidanceDistance = 200.0f;
+
+    UPROPERTY(EditAnywhere, Category = "Boids|Flocking")
+    float AlignmentWeight = 0.5f;
+
+    UPROPERTY(EditAnywhere, Category = "Boids|Flocking")
+    float CohesionWeight = 0.3f;
+
+    UPROPERTY(EditAnywhere, Category = "Boids|Homing")
+    bool bHomeToPen = false;
+
+    UPROPERTY(EditAnywhere, Category = "Boids|Homing")
+    float HomingWeight = 0.5f;
+
+    // Height of the entity transform above the ground, the cow capsule's half height
+    UPROPERTY(EditAnywhere, Category = "Boids|Movement")
+    float GroundOffset = 90.0f;
+};
+
+namespace CowHerdMass
+{
+    // Ends the entity behind a cow actor that leaves the game for good, so the representation does not bring it back
+    void DestroyEntityForActor(const AActor* Cow);
+
+    // Tags the entity behind a cow actor while the cow is counted in a pen
+    void SetEntityPenned(const AActor* Cow, bool bPenned);
+
+    // Stable key of the live entity behind a cow actor, the same for every actor the representation spawns for it; 0 without one
+    uint64 GetEntityKey(const AActor* Cow);
+
+    // Whether the Mass representation is taking the actor away while its entity carries on, rather than the cow leaving
+    bool IsRepresentationDespawn(const AActor* Cow);
+}
@@ -0,0 +1,221 @@
+// CowHerdMassProcessor.cpp
+#include "CowHerdMassProcessor.h"
+#include "CowHerdMass.h"
+#include "CowHerdSubsystem.h"
+#include "CowHerdFieldData.h"
+#include "CowHerdKernels.h"
+#include "BoidsSteering.h"
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+#include "MassActorSubsystem.h"
+#include "Engine/World.h"
+
+UCowHerdMassProcessor::UCowHerdMassProcessor()
+    : EntityQuery(*this)
+{
+    ExecutionFlags = int32(EProcessorExecutionFlags::AllNetModes);
+    ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::Movement;
+
+    // Reads cow actors and the herd subsystem
+    bRequiresGameThreadExecution = true;
+}
+
+void UCowHerdMassProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FCowHerdMassFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FMassActorFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+    EntityQuery.AddConstSharedRequirement<FCowHerdMassParameters>();
+    EntityQuery.AddTagRequirement<FCowHerdMassTag>(EMassFragmentPresence::All);
+}
+
+void UCowHerdMassProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    const float DeltaTime = Context.GetDeltaTimeSeconds();
+    const UWorld* World = EntityManager.GetWorld();
+    if (DeltaTime <= 0.0f || !World)
+        return;
+
+    const UCowHerdSubsystem* HerdSubsystem = World->GetSubsystem<UCowHerdSubsystem>();
+
+    // Pass 1: cows with an actor take its pose, then everyone goes into the neighbor grid
+    Positions.Reset();
+    Velocities.Reset();
+    float MaxSeparationRadius = 0.0f;
+
+    EntityQuery.ForEachEntityChunk(Context, [this, &MaxSeparationRadius](FMassExecutionContext& Context)
+    {
+        const TArrayView<FTransformFragment> Transforms = Context.GetMutableFragmentView<FTransformFragment>();
+        const TArrayView<FCowHerdMassFragment> Cows = Context.GetMutableFragmentView<FCowHerdMassFragment>();
+        const TConstArrayView<FMassActorFragment> Actors = Context.GetFragmentView<FMassActorFragment>();
+        const FCowHerdMassParameters& Parameters = Context.GetConstSharedFragment<FCowHerdMassParameters>();
+
+        MaxSeparationRadius = FMath::Max(MaxSeparationRadius, Parameters.SeparationRadius);
+
+        for (int32 Entity = 0; Entity < Context.GetNumEntities(); ++Entity)
+        {
+            FTransform& Transform = Transforms[Entity].GetMutableTransform();
+            FCowHerdMassFragment& Cow = Cows[Entity];
+
+            if (!Cow.bInitialized)
+            {
+                // Seeded from the entity so a spawn replays the same herd
+                Cow.RandomStream.Initialize(int32(GetTypeHash(Context.GetEntity(Entity))));
+                Cow.WanderTarget = FVector(Cow.RandomStream.FRandRange(-1.0f, 1.0f), Cow.RandomStream.FRandRange(-1.0f, 1.0f), 0.0f).GetSafeNormal() * Parameters.WanderRadius;
+                Cow.bInitialized = true;
+            }
+
+            // The actor is authoritative while it exists; when it goes away the entity carries on from here
+            if (const AActor* Actor = Actors.Num() > 0 ? Actors[Entity].Get() : nullptr)
+            {
+                Transform.SetLocation(Actor->GetActorLocation());
+                Transform.SetRotation(Actor->GetActorQuat());
+                Cow.Velocity = Actor->GetVelocity();
+            }
+
+            Positions.Add(Transform.GetLocation());
+            Velocities.Add(Cow.Velocity);
+        }
+    });
+
+    SpatialGrid.Build(Positions, Velocities, FMath::Max(MaxSeparationRadius, 50.0f), [](int32) { return true; });
+
+    // Pass 2: steer and move the cows without an actor
+    int32 Index = 0;
+    EntityQuery.ForEachEntityChunk(Context, [this, &Index, HerdSubsystem, DeltaTime](FMassExecutionContext& Context)
+    {
+        const TArrayView<FTransformFragment> Transforms = Context.GetMutableFragmentView<FTransformFragment>();
+        const TArrayView<FCowHerdMassFragment> Cows = Context.GetMutableFragmentView<FCowHerdMassFragment>();
+        const TConstArrayView<FMassActorFragment> Actors = Context.GetFragmentView<FMassActorFragment>();
+        const FCowHerdMassParameters& Parameters = Context.GetConstSharedFragment<FCowHerdMassParameters>();
+
+        // Counted cows stay in their pen, they still push the others away through the grid
+        const bool bPenned = Context.DoesArchetypeHaveTag<FCowHerdMassPennedTag>();
+
+        for (int32 Entity = 0; Entity < Context.GetNumEntities(); ++Entity, ++Index)
+        {
+            if (Actors.Num() > 0 && Actors[Entity].Get())
+                continue;
+
+            if (bPenned)
+            {
+                Cows[Entity].Velocity = FVector::ZeroVector;
+                continue;
+            }
+
+            FTransform& Transform = Transforms[Entity].GetMutableTransform();
+            FCowHerdMassFragment& Cow = Cows[Entity];
+            const FVector Location = Positions[Index];
+            const float MaxSpeed = Parameters.WanderSpeed;
+
+            // Separation, through the same kernel as the actor herd
+            constexpr int32 BatchSize = 64;
+            alignas(16) float OffsetX[BatchSize];
+            alignas(16) float OffsetY[BatchSize];
+            alignas(16) float OffsetZ[BatchSize];
+            int32 NumPacked = 0;
+            CowHerdKernels::FSeparationSum Separation;
+
+            SpatialGrid.ForEachInRadius(Location, Parameters.SeparationRadius, [&](int32 Other, const FVector& OtherLocation, float DistanceSquared)
+            {
+                if (Other == Index)
+                    return;
+
+                const FVector Offset = Location - OtherLocation;
+                OffsetX[NumPacked] = float(Offset.X);
+                OffsetY[NumPacked] = float(Offset.Y);
+                OffsetZ[NumPacked] = float(Offset.Z);
+
+                if (++NumPacked == BatchSize)
+                {
+                    CowHerdKernels::AccumulateSeparation(OffsetX, OffsetY, OffsetZ, NumPacked, Parameters.SeparationRadius, Separation);
+                    NumPacked = 0;
+                }
+            });
+            CowHerdKernels::AccumulateSeparation(OffsetX, OffsetY, OffsetZ, NumPacked, Parameters.SeparationRadius, Separation);
+
+            FVector SteeringForce = BoidsSteering::Separation(Separation, Cow.Velocity, MaxSpeed) * Parameters.SeparationWeight;
+
+            // Flocking from the grid's cell sums, without this cow
+            FCowHerdSpatialGrid::FAggregate Neighborhood = SpatialGrid.SumNeighborhood(Location);
+            Neighborhood.PositionSum -= Location;
+            Neighborhood.VelocitySum -= Velocities[Index];
+            --Neighborhood.Count;
+            if (Neighborhood.Count > 0)
+            {
+                SteeringForce += BoidsSteering::Alignment(Neighborhood.VelocitySum / Neighborhood.Count, Cow.Velocity, MaxSpeed) * Parameters.AlignmentWeight;
+                SteeringForce += BoidsSteering::Cohesion(Location, Cow.Velocity, Neighborhood.PositionSum / Neighborhood.Count, MaxSpeed) * Parameters.CohesionWeight;
+            }
+
+            // Walls and blockers come from the herd fields only, far cows never trace
+            float WallDistance;
+            FVector WallNormal;
+            bool bAvoidingWall = false;
+            if (HerdSubsystem && HerdSubsystem->SampleWallField(Location, WallDistance, WallNormal)
+                && WallDistance < Parameters.WallAvoidanceDistance && FVector::DotProduct(Cow.Velocity, WallNormal) < 0)
+            {
+                const float AvoidanceStrength = 1.0f - FMath::Max(WallDistance, 0.0f) / Parameters.WallAvoidanceDistance;
+                SteeringForce += BoidsSteering::Steer(WallNormal, Cow.Velocity, MaxSpeed * AvoidanceStrength) * Parameters.ObstacleAvoidanceWeight;
+                bAvoidingWall = true;
+            }
+
+            FVector2D HomeDirection;
+            float HomeDistance;
+            if (HerdSubsystem && (Parameters.bHomeToPen || HerdSubsystem->IsPenAssistEnabled())
+                && HerdSubsystem->SampleFlowField(Location, HomeDirection, HomeDistance) && HomeDistance > 0.0f)
+            {
+                SteeringForce += BoidsSteering::Steer(FVector(HomeDirection, 0.0f), Cow.Velocity, MaxSpeed) * Parameters.HomingWeight;
+            }
+
+            if (!bAvoidingWall)
+            {
+                BoidsSteering::FWanderParams WanderParams;
+                WanderParams.Speed = Parameters.WanderSpeed;
+                WanderParams.Radius = Parameters.WanderRadius;
+                WanderParams.Distance = Parameters.WanderDistance;
+                WanderParams.Jitter = Parameters.WanderJitter;
+                SteeringForce += BoidsSteering::Wander(Cow.WanderTarget, Cow.RandomStream, Transform.GetRotation(), Cow.Velocity, WanderParams);
+            }
+
+            SteeringForce = BoidsSteering::LimitVector(SteeringForce, Parameters.MaxSteerForce);
+            Cow.Velocity = BoidsSteering::LimitVector(Cow.Velocity + SteeringForce * DeltaTime, MaxSpeed);
+            Cow.Velocity.Z = 0.0f;
+
+            // Stay on the baked ground; a step that would leave it keeps the cow where it was and bounces it off the edge
+            FVector NewLocation = Location + Cow.Velocity * DeltaTime;
+            const UCowHerdFieldData* Field = HerdSubsystem ? HerdSubsystem->FindHerdField(FVector2D(NewLocation)) : nullptr;
+            bool bHasGround = true;
+            float GroundHeight = 0.0f;
+            if (Field && Field->SampleGround(FVector2D(NewLocation), bHasGround, GroundHeight))
+            {
+                if (bHasGround)
+                {
+                    NewLocation.Z = GroundHeight + Parameters.GroundOffset;
+                }
+                else
+                {
+                    // Reflect off the edge along the cliff normal; without a usable normal turn the cow around
+                    float CliffDistance;
+                    FVector2D CliffNormal;
+                    if (Field->SampleCliffDistance(FVector2D(Location), CliffDistance, CliffNormal) && !CliffNormal.IsNearlyZero()
+                        && FVector2D::DotProduct(FVector2D(Cow.Velocity), CliffNormal) < 0.0f)
+                    {
+                        Cow.Velocity = Cow.Velocity.MirrorByVector(FVector(CliffNormal, 0.0f));
+                    }
+                    else
+                    {
+                        Cow.Velocity = -Cow.Velocity;
+                    }
+                    NewLocation = Location;
+                }
+            }
+
+            Transform.SetLocation(NewLocation);
+            if (!Cow.Velocity.IsNearlyZero())
+            {
+                Transform.SetRotation(FRotationMatrix::MakeFromX(Cow.Velocity).ToQuat());
+            }
+        }
+    });
+}
@@ -0,0 +1,35 @@
+// CowHerdMassProcessor.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "CowHerdSpatialGrid.h"
+#include "CowHerdMassProcessor.generated.h"
+
+/**
+ *  Boids for herd cows living as Mass entities. Entities whose representation is a spawned cow actor
+ *  follow that actor, which UCowHerdSubsystem already steers; the others wander, separate, flock, keep
+ *  off walls and holes using the baked herd fields, and home toward pens, without any scene queries.
+ *  Shepherd and laser reactions need the actor, which the representation LOD spawns near the camera.
+ */
+UCLASS()
+class UCowHerdMassProcessor : public UMassProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UCowHerdMassProcessor();
+
+protected:
+    virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+    virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+    FMassEntityQuery EntityQuery;
+
+    // Every herd entity this frame, in query order, for neighbor lookups
+    FCowHerdSpatialGrid SpatialGrid;
+    TArray<FVector> Positions;
+    TArray<FVector> Velocities;
+};
@@ -0,0 +1,40 @@
+// CowHerdMassTrait.cpp
+#include "CowHerdMassTrait.h"
+#include "MassEntityTemplateRegistry.h"
+#include "MassEntityUtils.h"
+#include "MassCommonFragments.h"
+#include "MassActorSubsystem.h"
+#include "MassLODFragments.h"
+#include "MassRepresentationFragments.h"
+
+void UCowHerdMassTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
+{
+    FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(World);
+
+    BuildContext.AddFragment<FTransformFragment>();
+    BuildContext.AddFragment<FMassActorFragment>();
+    BuildContext.AddFragment<FCowHerdMassFragment>();
+    BuildContext.AddTag<FCowHerdMassTag>();
+
+    // What the representation needs to swap the cow actor in near the viewer and out far from it.
+    // The Visualization and LOD Collector traits add these too; the checks keep one config from adding them twice.
+    if (!BuildContext.HasFragment<FMassRepresentationFragment>())
+    {
+        BuildContext.AddFragment<FMassRepresentationFragment>();
+    }
+    if (!BuildContext.HasFragment<FMassRepresentationLODFragment>())
+    {
+        BuildContext.AddFragment<FMassRepresentationLODFragment>();
+    }
+    if (!BuildContext.HasFragment<FMassViewerInfoFragment>())
+    {
+        BuildContext.AddFragment<FMassViewerInfoFragment>();
+    }
+    if (!BuildContext.HasTag<FMassCollectLODViewerInfoTag>())
+    {
+        BuildContext.AddTag<FMassCollectLODViewerInfoTag>();
+    }
+
+    const FConstSharedStruct ParametersFragment = EntityManager.GetOrCreateConstSharedFragment(Parameters);
+    BuildContext.AddConstSharedFragment(ParametersFragment);
+}
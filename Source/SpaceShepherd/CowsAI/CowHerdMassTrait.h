@@ -0,0 +1,27 @@
+// CowHerdMassTrait.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTraitBase.h"
+#include "CowHerdMass.h"
+#include "CowHerdMassTrait.generated.h"
+
+/**
+ *  Makes a Mass entity a herd cow, for herds too big for one ACowCharacter per cow.
+ *  It adds the representation and LOD fragments itself; the Visualization trait in the same entity config
+ *  supplies the templates: the high resolution representation should be the cow Blueprint and the low resolutions instanced meshes. Near the camera
+ *  the representation spawns a real cow, which joins UCowHerdSubsystem like any other, so pickup, throwing,
+ *  traps and counting volumes keep working; farther out UCowHerdMassProcessor moves the entity itself.
+ */
+UCLASS(meta = (DisplayName = "Cow Herd"))
+class UCowHerdMassTrait : public UMassEntityTraitBase
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, Category = "Herd")
+    FCowHerdMassParameters Parameters;
+
+protected:
+    virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
+};
@@ -0,0 +1,55 @@
+// CowHerdNeighborLists.cpp
+#include "CowHerdNeighborLists.h"
+#include "CowHerdSpatialGrid.h"
+
+bool FCowHerdNeighborLists::NeedsRebuild(TConstArrayView<FVector> Positions, float Skin) const
+{
+    if (!bValid || Skin != BuildSkin || Positions.Num() != BuildPositions.Num())
+        return true;
+
+    // Two cows each moving half the skin toward each other is the most a pair can close in before a list misses it
+    const float LimitSquared = FMath::Square(Skin * 0.5f);
+    for (int32 Index = 0; Index < Positions.Num(); ++Index)
+    {
+        if (FVector::DistSquared(Positions[Index], BuildPositions[Index]) > LimitSquared)
+            return true;
+    }
+
+    return false;
+}
+
+void FCowHerdNeighborLists::Build(const FCowHerdSpatialGrid& Grid, TConstArrayView<FVector> Positions, float Skin,
+    TFunctionRef<float(int32)> GetRadius, TFunctionRef<bool(int32, int32)> ShouldPair)
+{
+    const int32 NumCows = Positions.Num();
+
+    Starts.SetNumUninitialized(NumCows + 1, EAllowShrinking::No);
+    Neighbors.Reset();
+
+    for (int32 Index = 0; Index < NumCows; ++Index)
+    {
+        Starts[Index] = Neighbors.Num();
+
+        Grid.ForEachInRadius(Positions[Index], GetRadius(Index) + Skin, [&](int32 Other, const FVector&, float)
+        {
+            if (ShouldPair(Index, Other))
+            {
+                Neighbors.Add(Other);
+            }
+        });
+    }
+    Starts[NumCows] = Neighbors.Num();
+
+    BuildPositions.Reset();
+    BuildPositions.Append(Positions.GetData(), Positions.Num());
+    BuildSkin = Skin;
+    bValid = true;
+}
+
+void FCowHerdNeighborLists::Reset()
+{
+    Starts.Empty();
+    Neighbors.Empty();
+    BuildPositions.Empty();
+    bValid = false;
+}
@@ -0,0 +1,43 @@
+// CowHerdNeighborLists.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FCowHerdSpatialGrid;
+
+/**
+ *  Verlet neighbor lists for separation. Each cow keeps every candidate within its radius plus a skin,
+ *  so the lists stay complete until some cow has moved half the skin since they were built.
+ *  Grazing cows cover that distance slowly, which lets most frames reuse the lists instead of querying the grid.
+ *  Lists are packed back to back in one array, so a rebuild allocates nothing once the buffers have grown.
+ */
+class FCowHerdNeighborLists
+{
+public:
+    // True when the lists were invalidated, the skin changed, or any cow moved more than half the skin since the last build
+    bool NeedsRebuild(TConstArrayView<FVector> Positions, float Skin) const;
+
+    // Rebuild from this frame's grid. Each cow gets the grid entries within GetRadius(Cow) + Skin that pass ShouldPair(Cow, Other).
+    void Build(const FCowHerdSpatialGrid& Grid, TConstArrayView<FVector> Positions, float Skin,
+        TFunctionRef<float(int32)> GetRadius, TFunctionRef<bool(int32, int32)> ShouldPair);
+
+    // Forces a rebuild on the next check, for when cows join, leave or change what they collide with
+    void Invalidate() { bValid = false; }
+
+    void Reset();
+
+    TConstArrayView<int32> GetNeighbors(int32 Index) const
+    {
+        return TConstArrayView<int32>(Neighbors.GetData() + Starts[Index], Starts[Index + 1] - Starts[Index]);
+    }
+
+private:
+    // Start of each cow's list in Neighbors, one entry per cow plus the end
+    TArray<int32> Starts;
+    TArray<int32> Neighbors;
+
+    // Where every cow stood when the lists were built
+    TArray<FVector> BuildPositions;
+    float BuildSkin = 0.0f;
+    bool bValid = false;
+};
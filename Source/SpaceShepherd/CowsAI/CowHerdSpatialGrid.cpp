@@ -0,0 +1,146 @@
+// CowHerdSpatialGrid.cpp
+#include "CowHerdSpatialGrid.h"
+
+void FCowHerdSpatialGrid::Build(TConstArrayView<FVector> Positions, TConstArrayView<FVector> Velocities, float InCellSize, TFunctionRef<bool(int32)> ShouldInclude)
+{
+    CellSize = FMath::Max(InCellSize, 1.0f);
+    InvCellSize = 1.0f / CellSize;
+
+    const int32 NumCows = Positions.Num();
+
+    // Keep roughly two buckets per cow so chains stay short
+    const int32 NumBuckets = FMath::RoundUpToPowerOfTwo(FMath::Max(NumCows * 2, 64));
+    BucketMask = NumBuckets - 1;
+
+    BucketStarts.SetNumUninitialized(NumBuckets + 1, EAllowShrinking::No);
+    FMemory::Memzero(BucketStarts.GetData(), BucketStarts.Num() * sizeof(int32));
+
+    CowBuckets.SetNumUninitialized(NumCows, EAllowShrinking::No);
+    CowCells.SetNumUninitialized(NumCows, EAllowShrinking::No);
+
+    // Count cows per bucket
+    int32 NumIncluded = 0;
+    for (int32 Index = 0; Index < NumCows; ++Index)
+    {
+        if (!ShouldInclude(Index))
+        {
+            CowBuckets[Index] = INDEX_NONE;
+            continue;
+        }
+
+        CowCells[Index] = GetCell(Positions[Index]);
+        CowBuckets[Index] = GetBucket(CowCells[Index]);
+        ++BucketStarts[CowBuckets[Index] + 1];
+        ++NumIncluded;
+    }
+
+    // Prefix sum turns counts into bucket start offsets
+    for (int32 Bucket = 1; Bucket <= NumBuckets; ++Bucket)
+    {
+        BucketStarts[Bucket] += BucketStarts[Bucket - 1];
+    }
+
+    SortedIndices.SetNumUninitialized(NumIncluded, EAllowShrinking::No);
+    SortedPositions.SetNumUninitialized(NumIncluded, EAllowShrinking::No);
+    SortedCells.SetNumUninitialized(NumIncluded, EAllowShrinking::No);
+
+    // Scatter cows into their buckets, using the next bucket's start as a write cursor that walks back
+    for (int32 Index = NumCows - 1; Index >= 0; --Index)
+    {
+        const int32 Bucket = CowBuckets[Index];
+        if (Bucket == INDEX_NONE)
+            continue;
+
+        const int32 Entry = --BucketStarts[Bucket + 1];
+        SortedIndices[Entry] = Index;
+        SortedPositions[Entry] = Positions[Index];
+        SortedCells[Entry] = CowCells[Index];
+    }
+
+    // Each bucket's start now sits one slot up, move them back into place
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        BucketStarts[Bucket] = BucketStarts[Bucket + 1];
+    }
+    BucketStarts[NumBuckets] = NumIncluded;
+
+    // Sum each occupied cell. Entries of one cell share a bucket, so the first entry of the cell
+    // found earlier in the bucket names its aggregate.
+    CellAggregates.Reset();
+    EntryAggregates.SetNumUninitialized(NumIncluded, EAllowShrinking::No);
+
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        const int32 BucketStart = BucketStarts[Bucket];
+        for (int32 Entry = BucketStart; Entry < BucketStarts[Bucket + 1]; ++Entry)
+        {
+            int32 Aggregate = INDEX_NONE;
+            for (int32 Other = BucketStart; Other < Entry; ++Other)
+            {
+                if (SortedCells[Other] == SortedCells[Entry])
+                {
+                    Aggregate = EntryAggregates[Other];
+                    break;
+                }
+            }
+
+            if (Aggregate == INDEX_NONE)
+            {
+                Aggregate = CellAggregates.AddDefaulted();
+            }
+
+            EntryAggregates[Entry] = Aggregate;
+            FAggregate& Sum = CellAggregates[Aggregate];
+            Sum.PositionSum += SortedPositions[Entry];
+            Sum.VelocitySum += Velocities[SortedIndices[Entry]];
+            ++Sum.Count;
+        }
+    }
+}
+
+FCowHerdSpatialGrid::FAggregate FCowHerdSpatialGrid::SumNeighborhood(const FVector& Center) const
+{
+    FAggregate Result;
+    if (SortedIndices.Num() == 0)
+        return Result;
+
+    const FIntVector CenterCell = GetCell(Center);
+    for (int32 X = -1; X <= 1; ++X)
+    {
+        for (int32 Y = -1; Y <= 1; ++Y)
+        {
+            for (int32 Z = -1; Z <= 1; ++Z)
+            {
+                const FIntVector Cell = CenterCell + FIntVector(X, Y, Z);
+                const int32 Bucket = GetBucket(Cell);
+
+                // Any entry of the cell leads to its sums
+                for (int32 Entry = BucketStarts[Bucket]; Entry < BucketStarts[Bucket + 1]; ++Entry)
+                {
+                    if (SortedCells[Entry] != Cell)
+                        continue;
+
+                    const FAggregate& Sum = CellAggregates[EntryAggregates[Entry]];
+                    Result.PositionSum += Sum.PositionSum;
+                    Result.VelocitySum += Sum.VelocitySum;
+                    Result.Count += Sum.Count;
+                    break;
+                }
+            }
+        }
+    }
+
+    return Result;
+}
+
+TArrayView<const int32> FCowHerdSpatialGrid::QueryRadius(const FVector& Center, float Radius, TArray<int32>& OutIndices) const
+{
+    OutIndices.Reset();
+
+    ForEachInRadius(Center, Radius, [&OutIndices](int32 CowIndex, const FVector&, float)
+    {
+        OutIndices.Add(CowIndex);
+    });
+
+    return OutIndices;
+}
@@ -0,0 +1,113 @@
+// CowHerdSpatialGrid.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ *  Uniform spatial hash over the herd, rebuilt once per frame from the herd position buffer.
+ *  Cows are bucketed with a counting sort, so once the buffers have grown neither rebuilds nor queries allocate.
+ *  Entries remember their exact cell, which filters out hash collisions and cells that share a bucket.
+ *  Each occupied cell also keeps the sum of its cows' positions and velocities, so herd-wide averages
+ *  around a point cost a few cell lookups instead of a walk over every neighbor.
+ */
+class FCowHerdSpatialGrid
+{
+public:
+    // Position and velocity sums over a group of cows
+    struct FAggregate
+    {
+        FVector PositionSum = FVector::ZeroVector;
+        FVector VelocitySum = FVector::ZeroVector;
+        int32 Count = 0;
+    };
+
+    // Rebuild from the herd positions and velocities; only cows passing ShouldInclude are inserted
+    void Build(TConstArrayView<FVector> Positions, TConstArrayView<FVector> Velocities, float InCellSize, TFunctionRef<bool(int32)> ShouldInclude);
+
+    // Visit every inserted cow within Radius of Center as Visitor(CowIndex, Position, DistanceSquared)
+    template <typename VisitorType>
+    void ForEachInRadius(const FVector& Center, float Radius, VisitorType&& Visitor) const;
+
+    // Fill OutIndices (reset, capacity kept) with cows within Radius of Center and return a view over it
+    TArrayView<const int32> QueryRadius(const FVector& Center, float Radius, TArray<int32>& OutIndices) const;
+
+    // Sums over the cell holding Center and every cell touching it
+    FAggregate SumNeighborhood(const FVector& Center) const;
+
+    float GetCellSize() const { return CellSize; }
+    int32 Num() const { return SortedIndices.Num(); }
+
+private:
+    FIntVector GetCell(const FVector& Position) const;
+    int32 GetBucket(const FIntVector& Cell) const;
+
+    float CellSize = 100.0f;
+    float InvCellSize = 0.01f;
+    int32 BucketMask = 0;
+
+    // Start of each bucket in the sorted arrays, NumBuckets + 1 entries
+    TArray<int32> BucketStarts;
+
+    // Cow entries sorted by bucket
+    TArray<int32> SortedIndices;
+    TArray<FVector> SortedPositions;
+    TArray<FIntVector> SortedCells;
+
+    // Per-cell sums, and which of them each sorted entry belongs to
+    TArray<FAggregate> CellAggregates;
+    TArray<int32> EntryAggregates;
+
+    // Scratch for the counting sort, one entry per cow in the herd
+    TArray<int32> CowBuckets;
+    TArray<FIntVector> CowCells;
+};
+
+FORCEINLINE FIntVector FCowHerdSpatialGrid::GetCell(const FVector& Position) const
+{
+    return FIntVector(
+        FMath::FloorToInt32(Position.X * InvCellSize),
+        FMath::FloorToInt32(Position.Y * InvCellSize),
+        FMath::FloorToInt32(Position.Z * InvCellSize));
+}
+
+FORCEINLINE int32 FCowHerdSpatialGrid::GetBucket(const FIntVector& Cell) const
+{
+    const uint32 Hash = (uint32(Cell.X) * 73856093u) ^ (uint32(Cell.Y) * 19349663u) ^ (uint32(Cell.Z) * 83492791u);
+    return int32(Hash & uint32(BucketMask));
+}
+
+template <typename VisitorType>
+void FCowHerdSpatialGrid::ForEachInRadius(const FVector& Center, float Radius, VisitorType&& Visitor) const
+{
+    if (SortedIndices.Num() == 0)
+        return;
+
+    const float RadiusSquared = Radius * Radius;
+    const FIntVector MinCell = GetCell(Center - FVector(Radius));
+    const FIntVector MaxCell = GetCell(Center + FVector(Radius));
+
+    for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+    {
+        for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+        {
+            for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+            {
+                const FIntVector Cell(X, Y, Z);
+                const int32 Bucket = GetBucket(Cell);
+
+                for (int32 Entry = BucketStarts[Bucket]; Entry < BucketStarts[Bucket + 1]; ++Entry)
+                {
+                    // Several cells can share a bucket, only take the entries that really live in this one
+                    if (SortedCells[Entry] != Cell)
+                        continue;
+
+                    const float DistanceSquared = FVector::DistSquared(Center, SortedPositions[Entry]);
+                    if (DistanceSquared <= RadiusSquared)
+                    {
+                        Visitor(SortedIndices[Entry], SortedPositions[Entry], DistanceSquared);
+                    }
+                }
+            }
+        }
+    }
+}
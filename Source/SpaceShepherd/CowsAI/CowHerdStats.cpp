@@ -0,0 +1,26 @@
+// CowHerdStats.cpp
+#include "CowHerdStats.h"
+
+DEFINE_STAT(STAT_HerdTick);
+DEFINE_STAT(STAT_HerdGather);
+DEFINE_STAT(STAT_HerdNeighborQuery);
+DEFINE_STAT(STAT_HerdFlowField);
+DEFINE_STAT(STAT_HerdDetection);
+DEFINE_STAT(STAT_HerdLOD);
+DEFINE_STAT(STAT_HerdSensing);
+DEFINE_STAT(STAT_HerdObstacleSensing);
+DEFINE_STAT(STAT_HerdCliffSensing);
+DEFINE_STAT(STAT_HerdSteering);
+DEFINE_STAT(STAT_HerdApply);
+
+DEFINE_STAT(STAT_HerdShepherdTick);
+DEFINE_STAT(STAT_HerdTrapTick);
+
+DEFINE_STAT(STAT_HerdCowsTicked);
+DEFINE_STAT(STAT_HerdTracesIssued);
+DEFINE_STAT(STAT_HerdNeighborsVisited);
+DEFINE_STAT(STAT_HerdNeighborListBuilds);
+DEFINE_STAT(STAT_HerdKinematicCows);
+DEFINE_STAT(STAT_HerdInfluenceCells);
+
+CSV_DEFINE_CATEGORY(Herd, true);
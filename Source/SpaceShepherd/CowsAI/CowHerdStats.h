@@ -0,0 +1,37 @@
+// CowHerdStats.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+// "stat herd": where the herd's frame time goes and how much work it did
+DECLARE_STATS_GROUP(TEXT("Herd"), STATGROUP_Herd, STATCAT_Advanced);
+
+// Herd tick stages
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Herd Tick"), STAT_HerdTick, STATGROUP_Herd, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gather"), STAT_HerdGather, STATGROUP_Herd, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Neighbor Query"), STAT_HerdNeighborQuery, STATGROUP_Herd, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Flow Field"), STAT_HerdFlowField, STATGROUP_Herd, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Detection"), STAT_HerdDetection, STATGROUP_Herd, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("LOD"), STAT_HerdLOD, STATGROUP_Herd, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sensing"), STAT_HerdSensing, STATGROUP_Herd, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Obstacle Sensing"), STAT_HerdObstacleSensing, STATGROUP_Herd, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cliff Sensing"), STAT_HerdCliffSensing, STATGROUP_Herd, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Steering"), STAT_HerdSteering, STATGROUP_Herd, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply"), STAT_HerdApply, STATGROUP_Herd, );
+
+// Actors that drive the herd from outside
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Shepherd Tick"), STAT_HerdShepherdTick, STATGROUP_Herd, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Trap Tick"), STAT_HerdTrapTick, STATGROUP_Herd, );
+
+// Per-frame work counters
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cows Ticked"), STAT_HerdCowsTicked, STATGROUP_Herd, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces Issued"), STAT_HerdTracesIssued, STATGROUP_Herd, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Neighbors Visited"), STAT_HerdNeighborsVisited, STATGROUP_Herd, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Neighbor List Builds"), STAT_HerdNeighborListBuilds, STATGROUP_Herd, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Kinematic Cows"), STAT_HerdKinematicCows, STATGROUP_Herd, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Influence Cells"), STAT_HerdInfluenceCells, STATGROUP_Herd, );
+
+// Herd columns in CSV profiler captures (-csvCaptureFrames or csvprofile start)
+CSV_DECLARE_CATEGORY_EXTERN(Herd);
@@ -0,0 +1,2275 @@
+// CowHerdSubsystem.cpp
+#include "CowHerdSubsystem.h"
+#include "CowHerdStats.h"
+#include "CowHerdKernels.h"
+#include "BoidsSteering.h"
+#include "CowHerdFieldData.h"
+#include "CowHerdBlockerComponent.h"
+#include "CowBoidsComponent.h"
+#include "CowCharacter.h"
+#include "PlayerShepherdComponent.h"
+#include "HerdingGameMode/CowCountingVolume.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "DrawDebugHelpers.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Count.h"
+#include "SignificanceManager.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+static TAutoConsoleVariable<bool> CVarHerdParallelSteering(
+    TEXT("Herd.ParallelSteering"),
+    true,
+    TEXT("Compute cow steering on worker threads. When false the herd steers on the game thread."));
+
+static TAutoConsoleVariable<bool> CVarHerdAsyncSensing(
+    TEXT("Herd.AsyncSensing"),
+    true,
+    TEXT("Issue cow obstacle and cliff probes as async traces and steer on the previous frame's results."));
+
+static TAutoConsoleVariable<int32> CVarHerdSensingBudget(
+    TEXT("Herd.SensingBudget"),
+    0,
+    TEXT("Maximum number of cows that get fresh obstacle and cliff queries per frame, picked by urgency. 0 refreshes every cow."));
+
+static TAutoConsoleVariable<bool> CVarHerdLogSensing(
+    TEXT("Herd.LogSensing"),
+    false,
+    TEXT("Log how many cows were refreshed by the sensing scheduler each frame."));
+
+TRACE_DECLARE_INT_COUNTER(HerdSensedCows, TEXT("Herd/SensedCows"));
+
+static TAutoConsoleVariable<float> CVarHerdNeighborSkin(
+    TEXT("Herd.NeighborSkin"),
+    50.0f,
+    TEXT("Extra radius kept in each cow's separation neighbor list. The lists are rebuilt once any cow moves half of it;\n")
+    TEXT("0 rebuilds them every frame."));
+
+TRACE_DECLARE_INT_COUNTER(HerdNeighborListBuilds, TEXT("Herd/NeighborListBuilds"));
+
+static TAutoConsoleVariable<float> CVarHerdInfluenceCellSize(
+    TEXT("Herd.Influence.CellSize"),
+    100.0f,
+    TEXT("Cell size of the influence map shepherds, lasers and other sources stamp into.\n")
+    TEXT("Larger cells stamp faster but blur stop distances near a source."));
+
+static TAutoConsoleVariable<bool> CVarHerdLODEnabled(
+    TEXT("Herd.LOD.Enabled"),
+    true,
+    TEXT("Lower the simulation detail of cows far from the shepherd. When false every cow runs at full detail."));
+
+static TAutoConsoleVariable<float> CVarHerdLODFullDistance(
+    TEXT("Herd.LOD.FullDistance"),
+    4000.0f,
+    TEXT("Cows closer than this to the shepherd are steered and sensed every frame."));
+
+static TAutoConsoleVariable<float> CVarHerdLODReducedDistance(
+    TEXT("Herd.LOD.ReducedDistance"),
+    15000.0f,
+    TEXT("Cows closer than this run at reduced rate, beyond it they are frozen."));
+
+static TAutoConsoleVariable<float> CVarHerdLODHysteresis(
+    TEXT("Herd.LOD.Hysteresis"),
+    0.1f,
+    TEXT("Fraction of a tier distance a cow must cross beyond it before changing tier, to stop flicker."));
+
+static TAutoConsoleVariable<float> CVarHerdLODHiddenDistanceScale(
+    TEXT("Herd.LOD.HiddenDistanceScale"),
+    2.0f,
+    TEXT("Cows that were not rendered recently count as this many times farther away."));
+
+static TAutoConsoleVariable<int32> CVarHerdLODReducedInterval(
+    TEXT("Herd.LOD.ReducedInterval"),
+    4,
+    TEXT("Reduced rate cows are steered and sensed once every this many frames."));
+
+static TAutoConsoleVariable<bool> CVarHerdKinematicEnabled(
+    TEXT("Herd.Kinematic.Enabled"),
+    true,
+    TEXT("Move grazing cows away from every shepherd along the ground directly instead of through character movement."));
+
+static TAutoConsoleVariable<float> CVarHerdKinematicMargin(
+    TEXT("Herd.Kinematic.Margin"),
+    1000.0f,
+    TEXT("How far beyond its player detection radius a cow must be from every shepherd to move kinematically.\n")
+    TEXT("Cows get their character movement back at half this margin."));
+
+static TAutoConsoleVariable<float> CVarHerdRotationEpsilon(
+    TEXT("Herd.RotationEpsilon"),
+    0.25f,
+    TEXT("Smallest turn in degrees the herd writes to a cow actor; smaller turns are dropped until they add up."));
+
+static TAutoConsoleVariable<int32> CVarHerdFlowFieldCellsPerTick(
+    TEXT("Herd.FlowField.CellsPerTick"),
+    20000,
+    TEXT("Grid points a pen flow field rebuild may classify or settle per frame. The old field steers until the new one is done."));
+
+static TAutoConsoleVariable<float> CVarHerdFlowFieldClearance(
+    TEXT("Herd.FlowField.Clearance"),
+    60.0f,
+    TEXT("Distance pen flow field paths keep from walls and blockers."));
+
+static const FName CowSignificanceTag(TEXT("Cow"));
+
+static TAutoConsoleVariable<bool> CVarHerdDeterministic(
+    TEXT("Herd.Deterministic"),
+    false,
+    TEXT("Reproducible herd: steering, sensing and herd movement step at Herd.FixedStepRate, cows draw from streams seeded by Herd.Seed\n")
+    TEXT("and LOD is off. Shepherd input is not recorded or replayed, runs only match while the shepherds do the same on the same steps."));
+
+static TAutoConsoleVariable<float> CVarHerdFixedStepRate(
+    TEXT("Herd.FixedStepRate"),
+    60.0f,
+    TEXT("Steering steps per second in deterministic mode."));
+
+static TAutoConsoleVariable<int32> CVarHerdMaxFixedSteps(
+    TEXT("Herd.MaxFixedSteps"),
+    4,
+    TEXT("Most steering steps a deterministic frame may run; a longer backlog is dropped."));
+
+static TAutoConsoleVariable<int32> CVarHerdSeed(
+    TEXT("Herd.Seed"),
+    0x5EED,
+    TEXT("Seed for the per-cow random streams in deterministic mode, combined with each cow's registration order."));
+
+static TAutoConsoleVariable<int32> CVarHerdSteeringBatchSize(
+    TEXT("Herd.SteeringBatchSize"),
+    32,
+    TEXT("Minimum number of cows per parallel steering batch."));
+
+namespace
+{
+    BoidsSteering::FArriveParams GetAttractionParams(const UCowBoidsComponent& Boids)
+    {
+        BoidsSteering::FArriveParams Params;
+        Params.Speed = Boids.AttractionSpeed;
+        Params.StopDistance = Boids.AttractionStopDistance;
+        Params.SlowdownDistance = Boids.AttractionSlowdownDistance;
+        return Params;
+    }
+
+    BoidsSteering::FArriveParams GetLaserParams(const UCowBoidsComponent& Boids)
+    {
+        BoidsSteering::FArriveParams Params;
+        Params.Speed = Boids.LaserAttractionSpeed;
+        Params.StopDistance = Boids.LaserStopDistance;
+        Params.SlowdownDistance = Boids.LaserSlowdownDistance;
+        return Params;
+    }
+}
+
+// ========== Tick Function ==========
+
+void FCowHerdTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if (Target && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Target->TickHerd(DeltaTime);
+    }
+}
+
+FString FCowHerdTickFunction::DiagnosticMessage()
+{
+    return TEXT("FCowHerdTickFunction");
+}
+
+FName FCowHerdTickFunction::DiagnosticContext(bool bDetailed)
+{
+    return FName(TEXT("CowHerd"));
+}
+
+// ========== Subsystem Lifetime ==========
+
+bool UCowHerdSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCowHerdSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Run the herd where the boids components used to tick; every registered cow's movement waits on it,
+    // so it consumes this frame's input and MaxWalkSpeed, not last frame's
+    HerdTickFunction.bCanEverTick = true;
+    HerdTickFunction.TickGroup = TG_PrePhysics;
+    HerdTickFunction.Target = this;
+    HerdTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UCowHerdSubsystem::Deinitialize()
+{
+    if (HerdTickFunction.IsTickFunctionRegistered())
+    {
+        HerdTickFunction.UnRegisterTickFunction();
+    }
+    HerdTickFunction.Target = nullptr;
+
+    USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+
+    for (int32 Index = 0; Index < Cows.Num(); ++Index)
+    {
+        SetCowKinematic(Index, false);
+        SetCowLOD(Index, ECowHerdLOD::Full);
+        if (IsValid(Movements[Index]))
+        {
+            Movements[Index]->PrimaryComponentTick.RemovePrerequisite(this, HerdTickFunction);
+        }
+        if (SignificanceManager)
+        {
+            SignificanceManager->UnregisterObject(Characters[Index]);
+        }
+        if (Cows[Index])
+        {
+            Cows[Index]->HerdIndex = INDEX_NONE;
+        }
+    }
+
+    Cows.Empty();
+    Characters.Empty();
+    Movements.Empty();
+    Positions.Empty();
+    Rotations.Empty();
+    Velocities.Empty();
+    WanderTargets.Empty();
+    RandomStreams.Empty();
+    MaxSpeeds.Empty();
+    States.Empty();
+    ObstacleDirections.Empty();
+    ObstacleDistances.Empty();
+    CliffDirections.Empty();
+    SensorRays.Empty();
+    SensorAges.Empty();
+    SensingQueue.Empty();
+    MovementWrites.Empty();
+    LODTiers.Empty();
+    SteerTimes.Empty();
+    PendingSteerTimes.Empty();
+    KinematicMovers.Empty();
+    Viewpoints.Empty();
+    Influences.Empty();
+    Shepherds.Empty();
+    ShepherdStates.Empty();
+    HerdFields.Empty();
+    Blockers.Empty();
+    BlockerCircles.Empty();
+    Pens.Empty();
+    FlowFields.Empty();
+    FlowFieldBlockers.Empty();
+    bFlowFieldsDirty = false;
+    MaxCowSpeed = 0.0f;
+    NeighborLists.Reset();
+    InfluenceMap.Reset();
+
+    Super::Deinitialize();
+}
+
+// ========== Registration ==========
+
+void UCowHerdSubsystem::RegisterCow(UCowBoidsComponent* Boids)
+{
+    if (!Boids || Boids->HerdIndex != INDEX_NONE)
+        return;
+
+    // Only cows get boids behavior; other owners never had steering applied
+    ACowCharacter* Cow = Cast<ACowCharacter>(Boids->GetOwner());
+    if (!Cow || !Cow->GetCharacterMovement())
+        return;
+
+    UCharacterMovementComponent* Movement = Cow->GetCharacterMovement();
+    Movement->MaxWalkSpeed = Boids->WanderSpeed;
+
+    // Move only after the herd has written this frame's input and speed
+    Movement->PrimaryComponentTick.AddPrerequisite(this, HerdTickFunction);
+
+    // Separate only from cows of our own class unless told otherwise
+    if (!Boids->CowClass)
+        Boids->CowClass = Cow->GetClass();
+
+    // Each cow draws from its own stream so wander can run off the game thread.
+    // Deterministic runs seed it from the herd seed and the cow's registration order, which replays identically.
+    const int32 CowSeed = CVarHerdDeterministic.GetValueOnGameThread()
+        ? int32(HashCombine(uint32(CVarHerdSeed.GetValueOnGameThread()), uint32(NumCowsRegistered)))
+        : FMath::Rand();
+    ++NumCowsRegistered;
+    FRandomStream RandomStream(CowSeed);
+
+    // Initialize wander target
+    FVector WanderTarget = FVector(RandomStream.FRandRange(-1.0f, 1.0f), RandomStream.FRandRange(-1.0f, 1.0f), 0.0f);
+    WanderTarget.Normalize();
+    WanderTarget *= Boids->WanderRadius;
+
+    Boids->HerdIndex = Cows.Add(Boids);
+    Characters.Add(Cow);
+    Movements.Add(Movement);
+    Positions.Add(Cow->GetActorLocation());
+    Rotations.Add(Cow->GetActorQuat());
+    Velocities.Add(FVector::ZeroVector);
+    WanderTargets.Add(WanderTarget);
+    RandomStreams.Add(RandomStream);
+    MaxSpeeds.Add(Boids->WanderSpeed);
+    States.Add(ECowHerdState::Enabled);
+    ObstacleDirections.Add(FVector::ZeroVector);
+    ObstacleDistances.Add(0.0f);
+    CliffDirections.Add(FVector::ZeroVector);
+    SensorRays.AddDefaulted();
+    SensorAges.Add(UnsensedAge);
+    LODTiers.Add(ECowHerdLOD::Full);
+    SteerTimes.Add(0.0f);
+    PendingSteerTimes.Add(0.0f);
+    KinematicMovers.Add(false);
+    Influences.AddDefaulted();
+
+    RegisterCowSignificance(Boids->HerdIndex);
+    NeighborLists.Invalidate();
+}
+
+void UCowHerdSubsystem::UnregisterCow(UCowBoidsComponent* Boids)
+{
+    if (!Boids || !Cows.IsValidIndex(Boids->HerdIndex) || Cows[Boids->HerdIndex] != Boids)
+        return;
+
+    RemoveCowAt(Boids->HerdIndex);
+}
+
+void UCowHerdSubsystem::RemoveCowAt(int32 Index)
+{
+    // Hand the cow back with its movement running
+    SetCowKinematic(Index, false);
+    SetCowLOD(Index, ECowHerdLOD::Full);
+
+    if (IsValid(Movements[Index]))
+    {
+        Movements[Index]->PrimaryComponentTick.RemovePrerequisite(this, HerdTickFunction);
+    }
+
+    if (USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+    {
+        SignificanceManager->UnregisterObject(Characters[Index]);
+    }
+
+    Cows[Index]->HerdIndex = INDEX_NONE;
+
+    Cows.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Characters.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Movements.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Positions.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Rotations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    WanderTargets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    RandomStreams.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    MaxSpeeds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    States.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    ObstacleDirections.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    ObstacleDistances.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    CliffDirections.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    SensorRays.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    SensorAges.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    LODTiers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    SteerTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    PendingSteerTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    KinematicMovers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+    Influences.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+    // The last cow now lives in the freed slot
+    if (Cows.IsValidIndex(Index))
+    {
+        Cows[Index]->HerdIndex = Index;
+    }
+
+    NeighborLists.Invalidate();
+    bSpatialGridStale = true;
+}
+
+void UCowHerdSubsystem::RegisterShepherd(UPlayerShepherdComponent* Shepherd)
+{
+    if (Shepherd)
+    {
+        Shepherds.AddUnique(Shepherd);
+
+        // Tick after the shepherd, so cows chase the laser point it traced this frame rather than last frame's
+        HerdTickFunction.AddPrerequisite(Shepherd, Shepherd->PrimaryComponentTick);
+    }
+}
+
+void UCowHerdSubsystem::UnregisterShepherd(UPlayerShepherdComponent* Shepherd)
+{
+    Shepherds.Remove(Shepherd);
+
+    if (Shepherd)
+    {
+        HerdTickFunction.RemovePrerequisite(Shepherd, Shepherd->PrimaryComponentTick);
+    }
+}
+
+UPlayerShepherdComponent* UCowHerdSubsystem::FindNearestShepherd(const FVector& Location) const
+{
+    UPlayerShepherdComponent* Nearest = nullptr;
+    float NearestDistanceSquared = TNumericLimits<float>::Max();
+
+    // A handful of players at most, a scan beats any structure
+    for (UPlayerShepherdComponent* Shepherd : Shepherds)
+    {
+        if (!IsValid(Shepherd) || !Shepherd->GetOwner())
+            continue;
+
+        const float DistanceSquared = FVector::DistSquared(Location, Shepherd->GetOwner()->GetActorLocation());
+        if (DistanceSquared < NearestDistanceSquared)
+        {
+            NearestDistanceSquared = DistanceSquared;
+            Nearest = Shepherd;
+        }
+    }
+
+    return Nearest;
+}
+
+int32 UCowHerdSubsystem::FindNearestShepherdIndex(const FVector& Location) const
+{
+    int32 Nearest = INDEX_NONE;
+    float NearestDistanceSquared = TNumericLimits<float>::Max();
+
+    for (int32 ShepherdIndex = 0; ShepherdIndex < ShepherdStates.Num(); ++ShepherdIndex)
+    {
+        const float DistanceSquared = FVector::DistSquared(Location, ShepherdStates[ShepherdIndex].Location);
+        if (DistanceSquared < NearestDistanceSquared)
+        {
+            NearestDistanceSquared = DistanceSquared;
+            Nearest = ShepherdIndex;
+        }
+    }
+
+    return Nearest;
+}
+
+void UCowHerdSubsystem::RegisterHerdField(UCowHerdFieldData* Field)
+{
+    if (Field && Field->IsValidField() && !HerdFields.Contains(Field))
+    {
+        HerdFields.Add(Field);
+        FlowFields.AddDefaulted();
+        bFlowFieldsDirty = true;
+    }
+}
+
+void UCowHerdSubsystem::UnregisterHerdField(UCowHerdFieldData* Field)
+{
+    const int32 FieldIndex = HerdFields.Find(Field);
+    if (FieldIndex != INDEX_NONE)
+    {
+        HerdFields.RemoveAt(FieldIndex);
+        FlowFields.RemoveAt(FieldIndex);
+    }
+}
+
+const UCowHerdFieldData* UCowHerdSubsystem::FindHerdField(const FVector2D& Location) const
+{
+    // Levels carry one or two volumes, a linear scan is plenty
+    for (const UCowHerdFieldData* Field : HerdFields)
+    {
+        if (Field->ContainsPoint(Location))
+            return Field;
+    }
+    return nullptr;
+}
+
+void UCowHerdSubsystem::RegisterBlocker(UCowHerdBlockerComponent* Blocker)
+{
+    if (Blocker)
+    {
+        Blockers.AddUnique(Blocker);
+        bFlowFieldsDirty = true;
+    }
+}
+
+void UCowHerdSubsystem::UnregisterBlocker(UCowHerdBlockerComponent* Blocker)
+{
+    if (Blockers.RemoveSwap(Blocker) > 0)
+    {
+        bFlowFieldsDirty = true;
+    }
+}
+
+bool UCowHerdSubsystem::HasWallFieldAt(const FVector& Location) const
+{
+    const UCowHerdFieldData* Field = FindHerdField(FVector2D(Location));
+    return Field && Field->HasWallField();
+}
+
+bool UCowHerdSubsystem::ShouldTraceObstacles(int32 Index, const FVector& Origin) const
+{
+    // Inside a wall field the feelers are replaced by a field sample at resolve time;
+    // reduced detail cows only keep their cliff probes
+    return LODTiers[Index] == ECowHerdLOD::Full && !HasWallFieldAt(Origin);
+}
+
+bool UCowHerdSubsystem::SampleWallField(const FVector& Location, float& OutDistance, FVector& OutNormal) const
+{
+    const FVector2D Location2D(Location);
+    const UCowHerdFieldData* Field = FindHerdField(Location2D);
+
+    OutDistance = TNumericLimits<float>::Max();
+    bool bFound = false;
+
+    FVector2D Gradient;
+    if (Field && Field->SampleWallDistance(Location2D, OutDistance, Gradient))
+    {
+        OutNormal = FVector(Gradient, 0.0f);
+        bFound = true;
+    }
+
+    // Blockers are few, check them all wherever the cow is; the closest surface wins
+    for (const FVector4& Circle : BlockerCircles)
+    {
+        const FVector2D Away = Location2D - FVector2D(Circle.X, Circle.Y);
+        const float Distance = Away.Size() - Circle.W;
+        if (Distance < OutDistance)
+        {
+            OutDistance = Distance;
+            OutNormal = FVector(Away.GetSafeNormal(), 0.0f);
+            bFound = true;
+        }
+    }
+
+    return bFound;
+}
+
+void UCowHerdSubsystem::RegisterPen(ACowCountingVolume* Pen)
+{
+    if (Pen)
+    {
+        Pens.AddUnique(Pen);
+        bFlowFieldsDirty = true;
+    }
+}
+
+void UCowHerdSubsystem::UnregisterPen(ACowCountingVolume* Pen)
+{
+    if (Pens.RemoveSwap(Pen) > 0)
+    {
+        bFlowFieldsDirty = true;
+    }
+}
+
+ACowCountingVolume* UCowHerdSubsystem::FindPenContaining(const FVector& Location) const
+{
+    for (ACowCountingVolume* Pen : Pens)
+    {
+        if (IsValid(Pen) && Pen->GetPenBounds().IsInsideOrOn(Location))
+            return Pen;
+    }
+    return nullptr;
+}
+
+bool UCowHerdSubsystem::SampleFlowField(const FVector& Location, FVector2D& OutDirection, float& OutDistance) const
+{
+    const FVector2D Location2D(Location);
+    for (int32 FieldIndex = 0; FieldIndex < HerdFields.Num(); ++FieldIndex)
+    {
+        if (HerdFields[FieldIndex]->ContainsPoint(Location2D))
+            return FlowFields[FieldIndex].Sample(Location2D, OutDirection, OutDistance);
+    }
+    return false;
+}
+
+void UCowHerdSubsystem::UpdateFlowFields()
+{
+    if (HerdFields.Num() == 0)
+        return;
+
+    // A blocker that drifted more than a cell since the last build changes which points are walkable
+    if (!bFlowFieldsDirty)
+    {
+        float MinCellSize = TNumericLimits<float>::Max();
+        for (const UCowHerdFieldData* Field : HerdFields)
+        {
+            MinCellSize = FMath::Min(MinCellSize, Field->CellSize);
+        }
+
+        bFlowFieldsDirty = BlockerCircles.Num() != FlowFieldBlockers.Num();
+        for (int32 Blocker = 0; Blocker < BlockerCircles.Num() && !bFlowFieldsDirty; ++Blocker)
+        {
+            bFlowFieldsDirty = FVector2D::DistSquared(FVector2D(BlockerCircles[Blocker]), FVector2D(FlowFieldBlockers[Blocker])) > FMath::Square(MinCellSize);
+        }
+    }
+
+    // Let a running build finish before starting over, otherwise a blocker that keeps moving starves it
+    const bool bAnyBuilding = FlowFields.ContainsByPredicate([](const FCowHerdFlowField& FlowField) { return FlowField.IsBuilding(); });
+    if (bFlowFieldsDirty && !bAnyBuilding)
+    {
+        TArray<FBox, TInlineAllocator<4>> Goals;
+        for (const ACowCountingVolume* Pen : Pens)
+        {
+            // Pens destroyed mid-level may not have unregistered yet
+            if (IsValid(Pen))
+            {
+                Goals.Add(Pen->GetPenBounds());
+            }
+        }
+
+        FlowFieldBlockers = BlockerCircles;
+        const float Clearance = CVarHerdFlowFieldClearance.GetValueOnGameThread();
+        for (int32 FieldIndex = 0; FieldIndex < HerdFields.Num(); ++FieldIndex)
+        {
+            FlowFields[FieldIndex].BeginBuild(*HerdFields[FieldIndex], Goals, FlowFieldBlockers, Clearance);
+        }
+        bFlowFieldsDirty = false;
+    }
+
+    const int32 CellsPerTick = FMath::Max(CVarHerdFlowFieldCellsPerTick.GetValueOnGameThread(), 1);
+    for (FCowHerdFlowField& FlowField : FlowFields)
+    {
+        FlowField.StepBuild(CellsPerTick);
+    }
+}
+
+void UCowHerdSubsystem::SetCowEnabled(const UCowBoidsComponent* Boids, bool bEnabled)
+{
+    if (!Boids || !Cows.IsValidIndex(Boids->HerdIndex))
+        return;
+
+    // Whatever was sensed before the cow was switched off is stale by now
+    if (bEnabled && !HasState(Boids->HerdIndex, ECowHerdState::Enabled))
+    {
+        SensorAges[Boids->HerdIndex] = UnsensedAge;
+    }
+
+    // Whoever switches boids off (carrying, traps) expects a cow that moves normally
+    if (!bEnabled)
+    {
+        SetCowKinematic(Boids->HerdIndex, false);
+        SetCowLOD(Boids->HerdIndex, ECowHerdLOD::Full);
+
+        // Nothing senses a switched-off cow, so don't leave it looking attracted or repulsed
+        if (HasState(Boids->HerdIndex, ECowHerdState::Attracted | ECowHerdState::Repulsed | ECowHerdState::LaserActive))
+        {
+            Characters[Boids->HerdIndex]->SetPlayerAttraction(false);
+        }
+        SetState(Boids->HerdIndex, ECowHerdState::PlayerInRange | ECowHerdState::LaserActive | ECowHerdState::Attracted | ECowHerdState::Repulsed, false);
+    }
+
+    SetState(Boids->HerdIndex, ECowHerdState::Enabled, bEnabled);
+}
+
+FVector UCowHerdSubsystem::GetCowVelocity(const UCowBoidsComponent* Boids) const
+{
+    if (!Boids || !Cows.IsValidIndex(Boids->HerdIndex))
+        return FVector::ZeroVector;
+
+    return Velocities[Boids->HerdIndex];
+}
+
+bool UCowHerdSubsystem::IsCowEnabled(const UCowBoidsComponent* Boids) const
+{
+    if (!Boids || !Cows.IsValidIndex(Boids->HerdIndex))
+        return false;
+
+    return HasState(Boids->HerdIndex, ECowHerdState::Enabled);
+}
+
+void UCowHerdSubsystem::SetState(int32 Index, ECowHerdState State, bool bValue)
+{
+    if (bValue)
+    {
+        EnumAddFlags(States[Index], State);
+    }
+    else
+    {
+        EnumRemoveFlags(States[Index], State);
+    }
+}
+
+// ========== Herd Update ==========
+
+void UCowHerdSubsystem::TickHerd(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_HerdTick);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UCowHerdSubsystem::TickHerd);
+
+    LastTickStats = FCowHerdTickStats();
+    NumSceneQueries = 0;
+    MaxCowSpeed = 0.0f;
+
+    if (Cows.Num() == 0)
+    {
+        // Nobody to sample it, but queued sources shouldn't pile up
+        InfluenceMap.Reset();
+        return;
+    }
+
+    // Stage wall times for the benchmark and profiling, each call closes the stage that just ran
+    const double TickStart = FPlatformTime::Seconds();
+    double StageStart = TickStart;
+    auto EndStage = [&StageStart](double& OutMs)
+    {
+        const double Now = FPlatformTime::Seconds();
+        OutMs = (Now - StageStart) * 1000.0;
+        StageStart = Now;
+    };
+
+    // Read actor state into the herd buffers once
+    {
+        SCOPE_CYCLE_COUNTER(STAT_HerdGather);
+        TRACE_CPUPROFILER_EVENT_SCOPE(CowHerd::Gather);
+        GatherCowState();
+    }
+    EndStage(LastTickStats.GatherMs);
+
+    {
+        SCOPE_CYCLE_COUNTER(STAT_HerdNeighborQuery);
+        TRACE_CPUPROFILER_EVENT_SCOPE(CowHerd::NeighborQuery);
+
+        // Bucket the herd for neighbor queries
+        BuildSpatialGrid();
+        UpdateNeighborLists();
+    }
+    EndStage(LastTickStats.GridMs);
+
+    // The shepherd is shared by the whole herd, look it up once per frame and stamp what it does into the influence map
+    {
+        SCOPE_CYCLE_COUNTER(STAT_HerdDetection);
+        TRACE_CPUPROFILER_EVENT_SCOPE(CowHerd::Shepherd);
+        UpdateShepherd();
+        UpdateInfluenceMap();
+    }
+    EndStage(LastTickStats.ShepherdMs);
+
+    // Pen flow fields follow pens and blockers, a slice of any pending rebuild per frame
+    {
+        SCOPE_CYCLE_COUNTER(STAT_HerdFlowField);
+        TRACE_CPUPROFILER_EVENT_SCOPE(CowHerd::FlowField);
+        UpdateFlowFields();
+    }
+    EndStage(LastTickStats.FlowFieldMs);
+
+    // Deterministic runs step in fixed steps, banking the remainder of the frame for the next one.
+    // The herd then moves its kinematic cows itself between steps, see IntegrateCows.
+    const bool bFixedStep = CVarHerdDeterministic.GetValueOnGameThread();
+    float StepTime = DeltaTime;
+    int32 NumSteps = 1;
+    if (bFixedStep)
+    {
+        StepTime = 1.0f / FMath::Max(CVarHerdFixedStepRate.GetValueOnGameThread(), 1.0f);
+        StepAccumulator += DeltaTime;
+        NumSteps = FMath::Min(FMath::FloorToInt32(StepAccumulator / StepTime), FMath::Max(CVarHerdMaxFixedSteps.GetValueOnGameThread(), 1));
+        StepAccumulator = FMath::Fmod(StepAccumulator - NumSteps * StepTime, StepTime);
+    }
+
+    // Sensing reads last frame's traces and issues this frame's, keep it on the game thread.
+    // A fixed-step frame that runs no step has nothing to sense for.
+    if (NumSteps > 0)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_HerdDetection);
+        TRACE_CPUPROFILER_EVENT_SCOPE(CowHerd::Detection);
+        for (int32 Index = 0; Index < Cows.Num(); ++Index)
+        {
+            if (HasState(Index, ECowHerdState::Enabled))
+            {
+                SenseCow(Index);
+            }
+        }
+    }
+    EndStage(LastTickStats.DetectionMs);
+
+    {
+        SCOPE_CYCLE_COUNTER(STAT_HerdLOD);
+        TRACE_CPUPROFILER_EVENT_SCOPE(CowHerd::LOD);
+        UpdateLOD(StepTime);
+        UpdateMovers();
+    }
+    EndStage(LastTickStats.LODMs);
+
+    if (NumSteps > 0)
+    {
+        SCOPE_CYCLE_COUNTER(STAT_HerdSensing);
+        TRACE_CPUPROFILER_EVENT_SCOPE(CowHerd::Sensing);
+        UpdateSensors();
+    }
+    EndStage(LastTickStats.SensingMs);
+
+    // Steering only reads and writes the herd buffers, so cows can be spread across workers.
+    // Each cow writes its own slots only; actors are not touched until the apply pass.
+    {
+        SCOPE_CYCLE_COUNTER(STAT_HerdSteering);
+        TRACE_CPUPROFILER_EVENT_SCOPE(CowHerd::Steering);
+
+        const EParallelForFlags SteeringFlags = CVarHerdParallelSteering.GetValueOnGameThread()
+            ? EParallelForFlags::None
+            : EParallelForFlags::ForceSingleThread;
+
+        for (int32 Step = 0; Step < NumSteps; ++Step)
+        {
+            // Every step after the first starts from where the last one left the herd; its sensing counts as steering time
+            if (Step > 0)
+            {
+                PrepareFixedStep();
+            }
+
+            ParallelFor(TEXT("CowHerdSteering"), Cows.Num(), FMath::Max(CVarHerdSteeringBatchSize.GetValueOnGameThread(), 1), [this](int32 Index)
+            {
+                if (SteerTimes[Index] > 0.0f)
+                {
+                    SimulateCow(Index, SteerTimes[Index]);
+                }
+            }, SteeringFlags);
+
+            if (bFixedStep)
+            {
+                IntegrateCows(StepTime);
+            }
+        }
+    }
+    EndStage(LastTickStats.SteeringMs);
+
+    // Write results back to the actors in one pass
+    {
+        SCOPE_CYCLE_COUNTER(STAT_HerdApply);
+        TRACE_CPUPROFILER_EVENT_SCOPE(CowHerd::Apply);
+        ApplyCowMovement(DeltaTime, bFixedStep);
+    }
+    EndStage(LastTickStats.ApplyMs);
+
+    for (int32 Index = 0; Index < Cows.Num(); ++Index)
+    {
+        if (Cows[Index]->bDebugDraw && HasState(Index, ECowHerdState::Enabled))
+        {
+            DrawDebugInfo(Index);
+        }
+    }
+
+    // Work counts and the top speed, read off the buffers afterwards so the steering workers share no counters
+    for (int32 Index = 0; Index < Cows.Num(); ++Index)
+    {
+        MaxCowSpeed = FMath::Max(MaxCowSpeed, MaxSpeeds[Index]);
+        if (SteerTimes[Index] > 0.0f)
+        {
+            ++LastTickStats.NumCowsTicked;
+            LastTickStats.NumNeighborsVisited += NeighborLists.GetNeighbors(Index).Num() * NumSteps;
+        }
+    }
+
+    LastTickStats.TotalMs = (FPlatformTime::Seconds() - TickStart) * 1000.0;
+    LastTickStats.NumSceneQueries = NumSceneQueries;
+    LastTickStats.NumSensed = NumSensedLastTick;
+    LastTickStats.NumKinematic = Algo::Count(KinematicMovers, true);
+    LastTickStats.NumInfluenceCells = InfluenceMap.GetNumStampedCells();
+    TRACE_COUNTER_SET(HerdNeighborListBuilds, LastTickStats.NumNeighborListBuilds);
+
+    ReportTickStats();
+}
+
+void UCowHerdSubsystem::ReportTickStats() const
+{
+    const FCowHerdTickStats& Stats = LastTickStats;
+
+    INC_DWORD_STAT_BY(STAT_HerdCowsTicked, Stats.NumCowsTicked);
+    INC_DWORD_STAT_BY(STAT_HerdTracesIssued, Stats.NumSceneQueries);
+    INC_DWORD_STAT_BY(STAT_HerdNeighborsVisited, Stats.NumNeighborsVisited);
+    INC_DWORD_STAT_BY(STAT_HerdNeighborListBuilds, Stats.NumNeighborListBuilds);
+    INC_DWORD_STAT_BY(STAT_HerdKinematicCows, Stats.NumKinematic);
+    INC_DWORD_STAT_BY(STAT_HerdInfluenceCells, Stats.NumInfluenceCells);
+
+    CSV_CUSTOM_STAT(Herd, TotalMs, float(Stats.TotalMs), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(Herd, GatherMs, float(Stats.GatherMs), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(Herd, NeighborQueryMs, float(Stats.GridMs), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(Herd, FlowFieldMs, float(Stats.FlowFieldMs), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(Herd, DetectionMs, float(Stats.ShepherdMs + Stats.DetectionMs), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(Herd, LODMs, float(Stats.LODMs), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(Herd, SensingMs, float(Stats.SensingMs), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(Herd, SteeringMs, float(Stats.SteeringMs), ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(Herd, ApplyMs, float(Stats.ApplyMs), ECsvCustomStatOp::Set);
+
+    CSV_CUSTOM_STAT(Herd, CowsTicked, Stats.NumCowsTicked, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(Herd, TracesIssued, Stats.NumSceneQueries, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(Herd, NeighborsVisited, Stats.NumNeighborsVisited, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(Herd, NeighborListBuilds, Stats.NumNeighborListBuilds, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(Herd, KinematicCows, Stats.NumKinematic, ECsvCustomStatOp::Set);
+    CSV_CUSTOM_STAT(Herd, InfluenceCells, Stats.NumInfluenceCells, ECsvCustomStatOp::Set);
+}
+
+void UCowHerdSubsystem::GatherCowState()
+{
+    // Cells match the largest separation radius so a query touches at most 3x3x3 cells
+    float MaxSeparationRadius = 0.0f;
+    MaxPlayerDetectionRadius = 0.0f;
+
+    for (int32 Index = 0; Index < Cows.Num(); ++Index)
+    {
+        const ACowCharacter* Cow = Characters[Index];
+        Positions[Index] = Cow->GetActorLocation();
+        Rotations[Index] = Cow->GetActorQuat();
+
+        // Carried cows have their collision turned off and shouldn't push the others around
+        const UCapsuleComponent* Capsule = Cow->GetCapsuleComponent();
+        const bool bCollidable = Capsule && Capsule->IsQueryCollisionEnabled();
+        if (bCollidable != HasState(Index, ECowHerdState::Collidable))
+        {
+            // Picked up or put down: the cow leaves or rejoins everyone's separation lists
+            NeighborLists.Invalidate();
+        }
+        SetState(Index, ECowHerdState::Collidable, bCollidable);
+
+        MaxSeparationRadius = FMath::Max(MaxSeparationRadius, Cows[Index]->SeparationRadius);
+        MaxPlayerDetectionRadius = FMath::Max(MaxPlayerDetectionRadius, Cows[Index]->PlayerDetectionRadius);
+    }
+
+    GridCellSize = FMath::Max(MaxSeparationRadius, 50.0f);
+
+    BlockerCircles.Reset();
+    for (const UCowHerdBlockerComponent* Blocker : Blockers)
+    {
+        const FVector Location = Blocker->GetOwner()->GetActorLocation();
+        BlockerCircles.Add(FVector4(Location.X, Location.Y, Location.Z, Blocker->BlockerRadius));
+    }
+}
+
+void UCowHerdSubsystem::BuildSpatialGrid()
+{
+    SpatialGrid.Build(Positions, Velocities, GridCellSize, [this](int32 Index)
+    {
+        return HasState(Index, ECowHerdState::Collidable);
+    });
+    bSpatialGridStale = false;
+}
+
+TArrayView<const int32> UCowHerdSubsystem::QueryCowsInRadius(const FVector& Center, float Radius)
+{
+    // Removals swap the last cow into the freed slot; rebuilding from the buffers puts the indices right again
+    if (bSpatialGridStale)
+    {
+        BuildSpatialGrid();
+    }
+
+    return SpatialGrid.QueryRadius(Center, Radius, QueryScratch);
+}
+
+void UCowHerdSubsystem::UpdateNeighborLists()
+{
+    // Separation lists carry a skin margin and only need refreshing once some cow has used up half of it
+    const float NeighborSkin = FMath::Max(CVarHerdNeighborSkin.GetValueOnGameThread(), 0.0f);
+    if (!NeighborLists.NeedsRebuild(Positions, NeighborSkin))
+        return;
+
+    NeighborLists.Build(SpatialGrid, Positions, NeighborSkin,
+        [this](int32 Index)
+        {
+            return Cows[Index]->SeparationRadius;
+        },
+        [this](int32 Index, int32 Other)
+        {
+            return Other != Index && Characters[Other]->IsA(Cows[Index]->CowClass);
+        });
+    ++LastTickStats.NumNeighborListBuilds;
+}
+
+void UCowHerdSubsystem::PrepareFixedStep()
+{
+    // Neighbors, influence and sensors at the step rate, from the positions the last step integrated to.
+    // The shepherds and the influence sources are this frame's, they only change with input.
+    BuildSpatialGrid();
+    UpdateNeighborLists();
+
+    for (int32 Index = 0; Index < Cows.Num(); ++Index)
+    {
+        if (HasState(Index, ECowHerdState::Enabled))
+        {
+            SenseCow(Index);
+        }
+    }
+
+    UpdateSensors();
+}
+
+void UCowHerdSubsystem::IntegrateCows(float DeltaTime)
+{
+    for (int32 Index = 0; Index < Cows.Num(); ++Index)
+    {
+        if (SteerTimes[Index] <= 0.0f)
+            continue;
+
+        Rotations[Index] = TurnTowardVelocity(Index, DeltaTime);
+
+        if (!KinematicMovers[Index])
+            continue;
+
+        FVector NewLocation;
+        if (MoveCowKinematically(Index, DeltaTime, NewLocation))
+        {
+            Positions[Index] = NewLocation;
+        }
+        else
+        {
+            // Walls and edges are left to character movement, which integrates on the frame time;
+            // the cow rejoins the fixed step once it is clear of them
+            SetCowKinematic(Index, false);
+        }
+    }
+}
+
+void UCowHerdSubsystem::UpdateShepherd()
+{
+    // Shepherds register themselves, this only drops ones that went away without saying so
+    Shepherds.RemoveAllSwap([](const UPlayerShepherdComponent* Shepherd)
+    {
+        return !IsValid(Shepherd) || !Shepherd->GetOwner();
+    });
+
+    ShepherdStates.Reset();
+    for (UPlayerShepherdComponent* Shepherd : Shepherds)
+    {
+        FCowHerdShepherd& State = ShepherdStates.AddDefaulted_GetRef();
+        State.Component = Shepherd;
+        State.Location = Shepherd->GetOwner()->GetActorLocation();
+
+        // The laser point is the same for every cow, only the distance check is per cow
+        State.bHasLaserTarget = Shepherd->IsLaserActive() && Shepherd->HasValidLaserTarget();
+        State.LaserAttractionPoint = State.bHasLaserTarget ? Shepherd->GetLaserAttractionPoint() : FVector::ZeroVector;
+    }
+}
+
+void UCowHerdSubsystem::UpdateInfluenceMap()
+{
+    // Each shepherd stamps what it is doing: calling or driving cows within the herd's detection reach,
+    // or luring them to its laser point. Other sources were queued through AddInfluenceSource.
+    // Shepherds that stood still leave the map as it was; cows get their flags written only on entering or leaving reach.
+    for (const FCowHerdShepherd& Shepherd : ShepherdStates)
+    {
+        if (Shepherd.bHasLaserTarget)
+        {
+            InfluenceMap.AddSource(ECowHerdInfluence::Lure, Shepherd.LaserAttractionPoint, Shepherd.Component->LaserAttractionRadius);
+        }
+
+        switch (Shepherd.Component->GetCurrentMode())
+        {
+            case EShepherdMode::Attraction:
+                InfluenceMap.AddSource(ECowHerdInfluence::Attraction, Shepherd.Location, MaxPlayerDetectionRadius);
+                break;
+            case EShepherdMode::Repulsion:
+                InfluenceMap.AddSource(ECowHerdInfluence::Repulsion, Shepherd.Location, MaxPlayerDetectionRadius);
+                break;
+            default:
+                break;
+        }
+    }
+
+    InfluenceMap.Build(FMath::Max(CVarHerdInfluenceCellSize.GetValueOnGameThread(), 10.0f));
+}
+
+void UCowHerdSubsystem::SenseCow(int32 Index)
+{
+    // One sample of the influence map stands in for checking every shepherd and laser
+    InfluenceMap.Sample(Positions[Index], Influences[Index]);
+
+    // Update player detection
+    UpdatePlayerDetection(Index);
+
+    // Update laser detection
+    UpdateLaserDetection(Index);
+}
+
+// ========== Level of Detail ==========
+
+void UCowHerdSubsystem::RegisterCowSignificance(int32 Index)
+{
+    USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+    if (!SignificanceManager)
+        return;
+
+    SignificanceManager->RegisterObject(Characters[Index], CowSignificanceTag,
+        [this](USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint)
+        {
+            return CalculateCowSignificance(Cast<AActor>(ObjectInfo->GetObject()), Viewpoint);
+        });
+}
+
+float UCowHerdSubsystem::CalculateCowSignificance(const AActor* Cow, const FTransform& Viewpoint) const
+{
+    if (!Cow)
+        return -UE_BIG_NUMBER;
+
+    // Distance to the shepherd, or to the camera when there is none. Off-screen cows count as farther.
+    // May run on worker threads, only reads state that is stable during the update.
+    const int32 Nearest = FindNearestShepherdIndex(Cow->GetActorLocation());
+    const FVector Anchor = ShepherdStates.IsValidIndex(Nearest) ? ShepherdStates[Nearest].Location : Viewpoint.GetLocation();
+    float Distance = FVector::Dist(Cow->GetActorLocation(), Anchor);
+
+    if (!Cow->WasRecentlyRendered(0.25f))
+    {
+        Distance *= CVarHerdLODHiddenDistanceScale.GetValueOnAnyThread();
+    }
+
+    // More significant is closer
+    return -Distance;
+}
+
+ECowHerdLOD UCowHerdSubsystem::SelectLOD(ECowHerdLOD Current, float Distance) const
+{
+    const float Hysteresis = FMath::Max(CVarHerdLODHysteresis.GetValueOnGameThread(), 0.0f);
+
+    // A tier boundary sits farther out while the cow is on its near side and closer in once it left,
+    // so hovering around a boundary doesn't flip the tier every frame
+    const float FullDistance = CVarHerdLODFullDistance.GetValueOnGameThread();
+    const float ReducedDistance = CVarHerdLODReducedDistance.GetValueOnGameThread();
+    const float FullLimit = FullDistance * (Current == ECowHerdLOD::Full ? 1.0f + Hysteresis : 1.0f - Hysteresis);
+    const float ReducedLimit = ReducedDistance * (Current != ECowHerdLOD::Frozen ? 1.0f + Hysteresis : 1.0f - Hysteresis);
+
+    if (Distance < FullLimit)
+        return ECowHerdLOD::Full;
+
+    return Distance < ReducedLimit ? ECowHerdLOD::Reduced : ECowHerdLOD::Frozen;
+}
+
+void UCowHerdSubsystem::SetCowLOD(int32 Index, ECowHerdLOD NewLOD)
+{
+    const ECowHerdLOD OldLOD = LODTiers[Index];
+    LODTiers[Index] = NewLOD;
+
+    UCharacterMovementComponent* MovementComponent = Movements[Index];
+    if (!IsValid(MovementComponent))
+        return;
+
+    if (NewLOD == ECowHerdLOD::Frozen)
+    {
+        Velocities[Index] = FVector::ZeroVector;
+
+        // Park the movement component, but let falling cows land first
+        if (MovementComponent->IsMovingOnGround())
+        {
+            MovementComponent->StopMovementImmediately();
+            MovementComponent->SetComponentTickEnabled(false);
+        }
+    }
+    else if (OldLOD == ECowHerdLOD::Frozen)
+    {
+        MovementComponent->SetComponentTickEnabled(!KinematicMovers[Index]);
+
+        // Cached sensor results are from before the freeze
+        SensorAges[Index] = UnsensedAge;
+    }
+
+    if (NewLOD != ECowHerdLOD::Reduced)
+    {
+        PendingSteerTimes[Index] = 0.0f;
+    }
+}
+
+void UCowHerdSubsystem::UpdateLOD(float DeltaTime)
+{
+    ++HerdFrame;
+
+    // LOD follows the camera and what got rendered, neither of which replays, so deterministic runs go without
+    const bool bUseLOD = CVarHerdLODEnabled.GetValueOnGameThread() && !CVarHerdDeterministic.GetValueOnGameThread();
+    USignificanceManager* SignificanceManager = bUseLOD ? USignificanceManager::Get(GetWorld()) : nullptr;
+
+    if (SignificanceManager)
+    {
+        // Every local player's camera is a viewpoint
+        Viewpoints.Reset();
+        for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+        {
+            if (const APlayerController* PlayerController = It->Get())
+            {
+                FVector ViewLocation;
+                FRotator ViewRotation;
+                PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+                Viewpoints.Emplace(ViewRotation, ViewLocation);
+            }
+        }
+
+        SignificanceManager->Update(Viewpoints);
+    }
+
+    const int32 ReducedInterval = FMath::Max(CVarHerdLODReducedInterval.GetValueOnGameThread(), 1);
+
+    for (int32 Index = 0; Index < Cows.Num(); ++Index)
+    {
+        SteerTimes[Index] = 0.0f;
+        if (!HasState(Index, ECowHerdState::Enabled))
+            continue;
+
+        // Without significance (no viewpoints yet, LOD off) everything runs at full detail.
+        // A cow chasing the laser matters however far it is.
+        ECowHerdLOD NewLOD = ECowHerdLOD::Full;
+        if (SignificanceManager && Viewpoints.Num() > 0 && !HasState(Index, ECowHerdState::LaserActive))
+        {
+            const float Distance = -SignificanceManager->GetSignificance(Characters[Index]);
+            NewLOD = SelectLOD(LODTiers[Index], Distance);
+        }
+
+        if (NewLOD != LODTiers[Index])
+        {
+            SetCowLOD(Index, NewLOD);
+        }
+
+        switch (LODTiers[Index])
+        {
+        case ECowHerdLOD::Full:
+            SteerTimes[Index] = DeltaTime;
+            break;
+
+        case ECowHerdLOD::Reduced:
+            // Cows take turns so the reduced ones are spread over the interval
+            PendingSteerTimes[Index] += DeltaTime;
+            if ((HerdFrame + Index) % ReducedInterval == 0)
+            {
+                SteerTimes[Index] = PendingSteerTimes[Index];
+                PendingSteerTimes[Index] = 0.0f;
+            }
+            break;
+
+        case ECowHerdLOD::Frozen:
+            // Cows that were still falling when frozen get parked once they land
+            if (Movements[Index]->IsComponentTickEnabled() && Movements[Index]->IsMovingOnGround())
+            {
+                Movements[Index]->StopMovementImmediately();
+                Movements[Index]->SetComponentTickEnabled(false);
+            }
+            break;
+        }
+    }
+}
+
+// ========== Kinematic Movement ==========
+
+void UCowHerdSubsystem::UpdateMovers()
+{
+    // Fixed-step herds move every cow they can themselves, so positions advance with the steps rather than the frame
+    const bool bKinematicEnabled = CVarHerdKinematicEnabled.GetValueOnGameThread() || CVarHerdDeterministic.GetValueOnGameThread();
+
+    for (int32 Index = 0; Index < Cows.Num(); ++Index)
+    {
+        const bool bKinematic = bKinematicEnabled && ShouldMoveKinematically(Index);
+        if (bKinematic != KinematicMovers[Index])
+        {
+            SetCowKinematic(Index, bKinematic);
+        }
+    }
+}
+
+bool UCowHerdSubsystem::ShouldMoveKinematically(int32 Index) const
+{
+    // Frozen cows stay parked; carried and disabled cows belong to whoever took them
+    if (!HasState(Index, ECowHerdState::Enabled) || !HasState(Index, ECowHerdState::Collidable) || LODTiers[Index] == ECowHerdLOD::Frozen)
+        return false;
+
+    // Anything falling or launched keeps full movement until it lands
+    const UCharacterMovementComponent* MovementComponent = Movements[Index];
+    if (!IsValid(MovementComponent) || (!KinematicMovers[Index] && !MovementComponent->IsMovingOnGround()))
+        return false;
+
+    // Fixed-step herds take every walking cow
+    if (CVarHerdDeterministic.GetValueOnGameThread())
+        return true;
+
+    // Otherwise only grazing cows
+    if (HasState(Index, ECowHerdState::PlayerInRange | ECowHerdState::LaserActive | ECowHerdState::Attracted | ECowHerdState::Repulsed))
+        return false;
+
+    // Cows working their way around a wall or an edge keep full movement until they are clear of it
+    if (!KinematicMovers[Index] && HasState(Index, ECowHerdState::AvoidingObstacle | ECowHerdState::AvoidingCliff))
+        return false;
+
+    // Keep clear of every shepherd by a margin, smaller once kinematic so cows don't flip at the boundary
+    const float Margin = FMath::Max(CVarHerdKinematicMargin.GetValueOnGameThread(), 0.0f) * (KinematicMovers[Index] ? 0.5f : 1.0f);
+    const float Range = Cows[Index]->PlayerDetectionRadius + Margin;
+    for (const FCowHerdShepherd& Shepherd : ShepherdStates)
+    {
+        if (FVector::DistSquared(Positions[Index], Shepherd.Location) < FMath::Square(Range))
+            return false;
+    }
+
+    return true;
+}
+
+void UCowHerdSubsystem::SetCowKinematic(int32 Index, bool bKinematic)
+{
+    if (KinematicMovers[Index] == bKinematic)
+        return;
+
+    KinematicMovers[Index] = bKinematic;
+
+    UCharacterMovementComponent* MovementComponent = Movements[Index];
+    if (!IsValid(MovementComponent))
+        return;
+
+    if (bKinematic)
+    {
+        MovementComponent->SetComponentTickEnabled(false);
+    }
+    else if (LODTiers[Index] != ECowHerdLOD::Frozen)
+    {
+        // Walking picks up from the herd's velocity and finds its floor on the next tick
+        MovementComponent->Velocity = Velocities[Index];
+        MovementComponent->SetComponentTickEnabled(true);
+    }
+}
+
+bool UCowHerdSubsystem::MoveCowKinematically(int32 Index, float DeltaTime, FVector& OutLocation)
+{
+    ACowCharacter* Cow = Characters[Index];
+    UCharacterMovementComponent* MovementComponent = Movements[Index];
+    const UCapsuleComponent* Capsule = Cow->GetCapsuleComponent();
+    if (!Capsule)
+        return false;
+
+    const float HalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+    const FVector Velocity(Velocities[Index].X, Velocities[Index].Y, 0.0f);
+    FVector NewLocation = Positions[Index] + Velocity * DeltaTime;
+
+    // Nothing sweeps here, so walls are the movement component's job once a cow gets close.
+    // Off the wall fields the feelers tell how close the last wall was.
+    const float CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+    float WallDistance;
+    FVector WallNormal;
+    if (SampleWallField(NewLocation, WallDistance, WallNormal) && WallDistance < CapsuleRadius)
+        return false;
+
+    if (!ObstacleDirections[Index].IsNearlyZero() && ObstacleDistances[Index] < CapsuleRadius && !HasWallFieldAt(NewLocation))
+        return false;
+
+    // Ground from the baked field, else one probe straight down within step height
+    const float FootZ = Positions[Index].Z - HalfHeight;
+    float GroundZ;
+    bool bHasGround = false;
+    const FVector2D Location2D(NewLocation);
+    const UCowHerdFieldData* Field = FindHerdField(Location2D);
+    if (!Field || !Field->SampleGround(Location2D, bHasGround, GroundZ))
+    {
+        const FVector Start(NewLocation.X, NewLocation.Y, FootZ + MovementComponent->MaxStepHeight);
+        const FVector End(NewLocation.X, NewLocation.Y, FootZ - MovementComponent->MaxStepHeight);
+        FCollisionQueryParams QueryParams;
+        QueryParams.AddIgnoredActor(Cow);
+
+        FHitResult Hit;
+        bHasGround = GetWorld()->LineTraceSingleByChannel(Hit, Start, End, ECC_WorldStatic, QueryParams);
+        ++NumSceneQueries;
+        GroundZ = Hit.ImpactPoint.Z;
+    }
+
+    // Edges and steps are what character movement is for
+    if (!bHasGround || FMath::Abs(GroundZ - FootZ) > MovementComponent->MaxStepHeight)
+        return false;
+
+    NewLocation.Z = GroundZ + HalfHeight;
+    OutLocation = NewLocation;
+    return true;
+}
+
+// ========== Sensing ==========
+
+void UCowHerdSubsystem::UpdateSensors()
+{
+    // Async results land a frame later whatever the step count, fixed-step herds trace on the step
+    const bool bAsyncSensing = CVarHerdAsyncSensing.GetValueOnGameThread() && !CVarHerdDeterministic.GetValueOnGameThread();
+    const int32 SensingBudget = CVarHerdSensingBudget.GetValueOnGameThread();
+
+    // Read back everything that went out last tick, trace data doesn't survive another frame
+    for (int32 Index = 0; Index < Cows.Num(); ++Index)
+    {
+        if (SensorAges[Index] < UnsensedAge - 1)
+        {
+            ++SensorAges[Index];
+        }
+
+        FCowSensorRays& Rays = SensorRays[Index];
+        if (!Rays.bPending)
+            continue;
+
+        FCowSensorHits Hits;
+        if (HasState(Index, ECowHerdState::Enabled) && CollectSensorHits(Index, Hits))
+        {
+            ResolveSensors(Index, Hits);
+            SensorAges[Index] = 0;
+        }
+        Rays.bPending = false;
+    }
+
+    // Rank the herd by urgency; staleness keeps the order rotating so every cow gets its turn
+    SensingQueue.Reset();
+    for (int32 Index = 0; Index < Cows.Num(); ++Index)
+    {
+        // Frozen cows don't sense, reduced ones only on the ticks they steer
+        if (HasState(Index, ECowHerdState::Enabled) && SteerTimes[Index] > 0.0f)
+        {
+            SensingQueue.Emplace(GetSensingPriority(Index), Index);
+        }
+    }
+
+    if (SensingBudget > 0 && SensingQueue.Num() > SensingBudget)
+    {
+        SensingQueue.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B)
+        {
+            return A.Key > B.Key;
+        });
+        SensingQueue.SetNum(SensingBudget, EAllowShrinking::No);
+    }
+
+    for (const TPair<float, int32>& Entry : SensingQueue)
+    {
+        const int32 Index = Entry.Value;
+        PrepareSensorRays(Index);
+
+        // Without async sensing, or for a cow with nothing usable cached (just registered or re-enabled),
+        // trace right away so it never steers blind
+        if (!bAsyncSensing || SensorAges[Index] == UnsensedAge)
+        {
+            FCowSensorHits Hits;
+            TraceSensorHits(Index, Hits);
+            ResolveSensors(Index, Hits);
+            SensorAges[Index] = 0;
+        }
+
+        if (bAsyncSensing)
+        {
+            IssueSensorTraces(Index);
+        }
+    }
+
+    NumSensedLastTick = SensingQueue.Num();
+    TRACE_COUNTER_SET(HerdSensedCows, NumSensedLastTick);
+
+    if (CVarHerdLogSensing.GetValueOnGameThread())
+    {
+        UE_LOG(LogTemp, Log, TEXT("CowHerd: sensed %d of %d cows (budget %d)"), NumSensedLastTick, Cows.Num(), SensingBudget);
+    }
+}
+
+float UCowHerdSubsystem::GetSensingPriority(int32 Index) const
+{
+    if (SensorAges[Index] == UnsensedAge)
+        return UE_BIG_NUMBER;
+
+    const UCowBoidsComponent& Boids = *Cows[Index];
+
+    // Fast cows cover more ground between refreshes
+    const float SpeedFactor = FMath::Clamp(Velocities[Index].Size() / FMath::Max(Boids.WanderSpeed, 1.0f), 0.0f, 4.0f);
+
+    // Cows already near a wall or an edge need their answers kept fresh
+    float HazardFactor = 0.0f;
+    if (!ObstacleDirections[Index].IsNearlyZero())
+    {
+        HazardFactor += 2.0f * (1.0f - ObstacleDistances[Index] / FMath::Max(Boids.WallAvoidanceDistance, 1.0f));
+    }
+    if (!CliffDirections[Index].IsZero())
+    {
+        HazardFactor += 2.0f;
+    }
+
+    return float(SensorAges[Index] + 1) * (1.0f + SpeedFactor + HazardFactor);
+}
+
+void UCowHerdSubsystem::SimulateCow(int32 Index, float DeltaTime)
+{
+    // Update max speed based on current behavior
+    UpdateMaxSpeed(Index);
+
+    // Calculate steering force
+    FVector SteeringForce = CalculateSteeringForce(Index, DeltaTime);
+
+    // Apply steering to velocity
+    Velocities[Index] += SteeringForce * DeltaTime;
+    Velocities[Index] = BoidsSteering::LimitVector(Velocities[Index], MaxSpeeds[Index]);
+}
+
+FQuat UCowHerdSubsystem::TurnTowardVelocity(int32 Index, float DeltaTime) const
+{
+    // Turn toward the movement direction about the vertical only, the capsule stays upright
+    const FVector& Velocity = Velocities[Index];
+    if (Velocity.SizeSquared() <= 0.1f)
+        return Rotations[Index];
+
+    const FRotator Target(0.0f, Velocity.Rotation().Yaw, 0.0f);
+    return FMath::RInterpTo(Rotations[Index].Rotator(), Target, DeltaTime, 5.0f).Quaternion();
+}
+
+void UCowHerdSubsystem::ApplyCowMovement(float DeltaTime, bool bStepped)
+{
+    const float RotationEpsilon = FMath::DegreesToRadians(FMath::Max(CVarHerdRotationEpsilon.GetValueOnGameThread(), 0.0f));
+
+    // Work out every cow's writes first, then touch the actors in one pass
+    MovementWrites.Reset();
+    for (int32 Index = 0; Index < Cows.Num(); ++Index)
+    {
+        if (!HasState(Index, ECowHerdState::Enabled) || LODTiers[Index] == ECowHerdLOD::Frozen)
+            continue;
+
+        FCowMovementWrite Write;
+        Write.Index = Index;
+        Write.Location = Positions[Index];
+
+        // Apply speed to movement component with optional interpolation
+        const UCowBoidsComponent& Boids = *Cows[Index];
+        const float WalkSpeed = Movements[Index]->MaxWalkSpeed;
+        Write.MaxWalkSpeed = Boids.bSmoothSpeedTransitions
+            ? FMath::FInterpTo(WalkSpeed, MaxSpeeds[Index], DeltaTime, Boids.SpeedTransitionRate)
+            : MaxSpeeds[Index];
+
+        // Kinematic cows move here, or already did during the fixed steps;
+        // one that can't gets its movement component back and walks from next frame
+        if (KinematicMovers[Index])
+        {
+            Write.bMove = bStepped || MoveCowKinematically(Index, DeltaTime, Write.Location);
+            if (!Write.bMove)
+            {
+                SetCowKinematic(Index, false);
+            }
+        }
+
+        if (!KinematicMovers[Index] && Velocities[Index].SizeSquared() > 0.1f)
+        {
+            Write.InputVector = Velocities[Index].GetSafeNormal();
+        }
+
+        // Turns too small to see aren't written at all
+        const FQuat Current = Characters[Index]->GetActorQuat();
+        Write.Rotation = bStepped ? Rotations[Index] : TurnTowardVelocity(Index, DeltaTime);
+        Write.bRotate = Current.AngularDistance(Write.Rotation) > RotationEpsilon;
+        if (!Write.bRotate)
+        {
+            Write.Rotation = Current;
+        }
+
+        MovementWrites.Add(Write);
+    }
+
+    for (const FCowMovementWrite& Write : MovementWrites)
+    {
+        ACowCharacter* Cow = Characters[Write.Index];
+        UCharacterMovementComponent* MovementComponent = Movements[Write.Index];
+        MovementComponent->MaxWalkSpeed = Write.MaxWalkSpeed;
+
+        if (!Write.InputVector.IsZero())
+        {
+            MovementComponent->AddInputVector(Write.InputVector);
+        }
+
+        if (!Write.bMove && !Write.bRotate)
+            continue;
+
+        // Every write for this cow lands in one deferred movement scope, so attachments and overlaps update
+        // once when it closes instead of after each call; a turn in place still updates both
+        FScopedMovementUpdate ScopedMovement(Cow->GetRootComponent(), EScopedUpdate::DeferredUpdates);
+
+        if (Write.bMove)
+        {
+            Cow->SetActorLocationAndRotation(Write.Location, Write.Rotation, false, nullptr, ETeleportType::None);
+
+            // Animation and anyone asking the pawn read velocity from the movement component
+            MovementComponent->Velocity = FVector(Velocities[Write.Index].X, Velocities[Write.Index].Y, 0.0f);
+        }
+        else if (Write.bRotate)
+        {
+            Cow->SetActorRotation(Write.Rotation, ETeleportType::None);
+        }
+    }
+}
+
+// ========== Boids Behaviors ==========
+
+void UCowHerdSubsystem::UpdateMaxSpeed(int32 Index)
+{
+    const UCowBoidsComponent& Boids = *Cows[Index];
+
+    // Determine current max speed based on behavior
+    float TargetSpeed = Boids.WanderSpeed;
+
+    const FCowHerdInfluence& Influence = Influences[Index];
+
+    // Laser attraction works independently of player distance
+    if (HasState(Index, ECowHerdState::LaserActive))
+    {
+        // Stop when close enough, slowing down on the way in
+        float DistanceToLaser = Influence[ECowHerdInfluence::Lure].Distance;
+        TargetSpeed = BoidsSteering::ArriveSpeed(DistanceToLaser, GetLaserParams(Boids));
+    }
+    // Only check normal player attraction if player is actually in range
+    else if (HasState(Index, ECowHerdState::PlayerInRange))
+    {
+        float DistanceToPlayer = Influence[ECowHerdInfluence::Attraction].Distance;
+
+        if (HasState(Index, ECowHerdState::Repulsed))
+        {
+            // Repulsion takes priority - cows run fastest when fleeing
+            TargetSpeed = Boids.RepulsionSpeed;
+        }
+        else if (HasState(Index, ECowHerdState::Attracted))
+        {
+            // Slow down as we approach the player
+            TargetSpeed = BoidsSteering::ArriveSpeed(DistanceToPlayer, GetAttractionParams(Boids));
+        }
+    }
+
+    // The movement component's walk speed follows this in the apply pass
+    MaxSpeeds[Index] = TargetSpeed;
+}
+
+FVector UCowHerdSubsystem::CalculateSteeringForce(int32 Index, float DeltaTime)
+{
+    const UCowBoidsComponent& Boids = *Cows[Index];
+    FVector SteeringForce = FVector::ZeroVector;
+
+    // 1. First priority: Obstacle and cliff avoidance (safety first!)
+    FVector ObstacleAvoid = CalculateObstacleAvoidance(Index);
+    FVector CliffAvoid = CalculateCliffAvoidance(Index);
+
+    // Check if we're actively avoiding
+    const bool bIsAvoidingObstacle = !ObstacleAvoid.IsNearlyZero();
+    const bool bIsAvoidingCliff = !CliffAvoid.IsNearlyZero();
+    SetState(Index, ECowHerdState::AvoidingObstacle, bIsAvoidingObstacle);
+    SetState(Index, ECowHerdState::AvoidingCliff, bIsAvoidingCliff);
+
+    // Apply safety forces with high priority
+    if (bIsAvoidingObstacle || bIsAvoidingCliff)
+    {
+        SteeringForce += ObstacleAvoid * Boids.ObstacleAvoidanceWeight * Boids.SafetyPriorityMultiplier;
+        SteeringForce += CliffAvoid * Boids.ObstacleAvoidanceWeight * Boids.SafetyPriorityMultiplier;
+    }
+    else
+    {
+        // Normal weights when not in danger
+        SteeringForce += ObstacleAvoid * Boids.ObstacleAvoidanceWeight;
+        SteeringForce += CliffAvoid * Boids.ObstacleAvoidanceWeight;
+    }
+
+    // 2. Separation from other cows
+    FVector Separation = CalculateSeparation(Index) * Boids.SeparationWeight;
+    SteeringForce += Separation;
+
+    // Alignment and cohesion keep the herd moving together
+    FVector Alignment, Cohesion;
+    CalculateFlocking(Index, Alignment, Cohesion);
+    SteeringForce += Alignment * Boids.AlignmentWeight;
+    SteeringForce += Cohesion * Boids.CohesionWeight;
+
+    // 3. Player/Laser interaction (reduced influence when avoiding obstacles)
+    float PlayerInfluenceReduction = (bIsAvoidingObstacle || bIsAvoidingCliff) ? 0.2f : 1.0f;
+
+    const bool bIsLaserActive = HasState(Index, ECowHerdState::LaserActive);
+    const bool bPlayerInRange = HasState(Index, ECowHerdState::PlayerInRange);
+    const bool bAttracted = HasState(Index, ECowHerdState::Attracted);
+    const bool bRepulsed = HasState(Index, ECowHerdState::Repulsed);
+
+    // Laser attraction works independently of player distance
+    if (bIsLaserActive)
+    {
+        FVector LaserForce = CalculateLaserAttraction(Index) * Boids.LaserAttractionWeight * PlayerInfluenceReduction;
+        SteeringForce += LaserForce;
+    }
+    // Only apply normal player attraction/repulsion if player is in range
+    else if (bPlayerInRange)
+    {
+        float DistanceToPlayer = Influences[Index][ECowHerdInfluence::Attraction].Distance;
+
+        if (bAttracted && DistanceToPlayer > Boids.AttractionStopDistance)
+        {
+            FVector PlayerForce = CalculatePlayerAttraction(Index) * Boids.AttractionWeight * PlayerInfluenceReduction;
+            SteeringForce += PlayerForce;
+        }
+        else if (bRepulsed)
+        {
+            FVector PlayerForce = CalculatePlayerRepulsion(Index) * Boids.RepulsionWeight * PlayerInfluenceReduction;
+            SteeringForce += PlayerForce;
+        }
+    }
+
+    // Homing toward the pens along the shared flow field, unless a laser is leading the cow
+    if (!bIsLaserActive && (Boids.bHomeToPen || bPenAssist))
+    {
+        SteeringForce += CalculatePenHoming(Index) * Boids.HomingWeight * PlayerInfluenceReduction;
+    }
+
+    // 4. Wander behavior (only if not interacting with player/laser and not avoiding obstacles)
+    if (!bIsAvoidingObstacle && !bIsAvoidingCliff && !bIsLaserActive)
+    {
+        if (!bPlayerInRange || (!bAttracted && !bRepulsed))
+        {
+            FVector Wander = CalculateWander(Index, DeltaTime);
+            SteeringForce += Wander;
+        }
+    }
+
+    // Limit steering force
+    SteeringForce = BoidsSteering::LimitVector(SteeringForce, Boids.MaxSteerForce);
+
+    return SteeringForce;
+}
+
+FVector UCowHerdSubsystem::CalculateSeparation(int32 Index)
+{
+    const UCowBoidsComponent& Boids = *Cows[Index];
+    const FVector MyLocation = Positions[Index];
+    const float SeparationRadius = Boids.SeparationRadius;
+
+    // Neighbor offsets are packed on the stack in batches, so this stays allocation free on worker threads
+    constexpr int32 BatchSize = 64;
+    alignas(16) float OffsetX[BatchSize];
+    alignas(16) float OffsetY[BatchSize];
+    alignas(16) float OffsetZ[BatchSize];
+    int32 NumPacked = 0;
+
+    CowHerdKernels::FSeparationSum Sum;
+
+    // The list holds every same-class cow that can be in range; the kernel drops the ones that aren't yet
+    for (const int32 Other : NeighborLists.GetNeighbors(Index))
+    {
+        const FVector Offset = MyLocation - Positions[Other];
+        OffsetX[NumPacked] = float(Offset.X);
+        OffsetY[NumPacked] = float(Offset.Y);
+        OffsetZ[NumPacked] = float(Offset.Z);
+
+        if (++NumPacked == BatchSize)
+        {
+            CowHerdKernels::AccumulateSeparation(OffsetX, OffsetY, OffsetZ, NumPacked, SeparationRadius, Sum);
+            NumPacked = 0;
+        }
+    }
+
+    CowHerdKernels::AccumulateSeparation(OffsetX, OffsetY, OffsetZ, NumPacked, SeparationRadius, Sum);
+
+    return BoidsSteering::Separation(Sum, Velocities[Index], MaxSpeeds[Index]);
+}
+
+void UCowHerdSubsystem::CalculateFlocking(int32 Index, FVector& OutAlignment, FVector& OutCohesion) const
+{
+    OutAlignment = FVector::ZeroVector;
+    OutCohesion = FVector::ZeroVector;
+
+    // Per-cell sums from the grid, a fixed number of lookups however crowded it gets
+    FCowHerdSpatialGrid::FAggregate Sum = SpatialGrid.SumNeighborhood(Positions[Index]);
+
+    // The cow is part of the sums if it went into the grid
+    if (HasState(Index, ECowHerdState::Collidable))
+    {
+        Sum.PositionSum -= Positions[Index];
+        Sum.VelocitySum -= Velocities[Index];
+        --Sum.Count;
+    }
+
+    if (Sum.Count <= 0)
+        return;
+
+    OutAlignment = BoidsSteering::Alignment(Sum.VelocitySum / Sum.Count, Velocities[Index], MaxSpeeds[Index]);
+    OutCohesion = BoidsSteering::Cohesion(Positions[Index], Velocities[Index], Sum.PositionSum / Sum.Count, MaxSpeeds[Index]);
+}
+
+FVector UCowHerdSubsystem::CalculateWander(int32 Index, float DeltaTime)
+{
+    const UCowBoidsComponent& Boids = *Cows[Index];
+
+    BoidsSteering::FWanderParams Params;
+    Params.Speed = Boids.WanderSpeed; // Use wander speed specifically
+    Params.Radius = Boids.WanderRadius;
+    Params.Distance = Boids.WanderDistance;
+    Params.Jitter = Boids.WanderJitter;
+
+    // Wander relative to the cow's facing
+    return BoidsSteering::Wander(WanderTargets[Index], RandomStreams[Index], Rotations[Index], Velocities[Index], Params);
+}
+
+void UCowHerdSubsystem::PrepareSensorRays(int32 Index)
+{
+    FCowSensorRays& Rays = SensorRays[Index];
+    Rays.Origin = Positions[Index];
+    Rays.Right = Rotations[Index].GetRightVector();
+    Rays.Forward = Velocities[Index].GetSafeNormal();
+
+    if (Rays.Forward.IsNearlyZero())
+        Rays.Forward = Rotations[Index].GetForwardVector();
+}
+
+void UCowHerdSubsystem::GetObstacleRay(int32 Index, int32 Ray, FVector& OutStart, FVector& OutEnd) const
+{
+    const FCowSensorRays& Rays = SensorRays[Index];
+
+    // Check multiple rays for better obstacle detection
+    FVector Direction = Rays.Forward;
+    if (Ray == 1)
+        Direction = (Rays.Forward + Rays.Right * 0.5f).GetSafeNormal();
+    else if (Ray == 2)
+        Direction = (Rays.Forward - Rays.Right * 0.5f).GetSafeNormal();
+
+    OutStart = Rays.Origin + FVector(0, 0, 50);
+    OutEnd = OutStart + Direction * Cows[Index]->WallAvoidanceDistance;
+}
+
+void UCowHerdSubsystem::GetGroundRay(int32 Index, int32 Ray, FVector& OutStart, FVector& OutEnd) const
+{
+    const FCowSensorRays& Rays = SensorRays[Index];
+    const float CliffAvoidanceDistance = Cows[Index]->CliffAvoidanceDistance;
+
+    // Ground straight ahead, then half as far to either side
+    FVector Ahead = Rays.Forward * CliffAvoidanceDistance;
+    if (Ray == 1)
+        Ahead = FVector::CrossProduct(Rays.Forward, FVector::UpVector) * CliffAvoidanceDistance * 0.5f;
+    else if (Ray == 2)
+        Ahead = -FVector::CrossProduct(Rays.Forward, FVector::UpVector) * CliffAvoidanceDistance * 0.5f;
+
+    // Cast ray downward from the end position
+    const FVector End = Rays.Origin + Ahead;
+    OutStart = End + FVector(0, 0, 100);
+    OutEnd = End - FVector(0, 0, 500);
+}
+
+bool UCowHerdSubsystem::SampleGroundField(int32 Index, bool (&OutGroundHits)[FCowSensorRays::NumGroundRays]) const
+{
+    const FCowSensorRays& Rays = SensorRays[Index];
+    const FVector2D Origin(Rays.Origin);
+
+    const UCowHerdFieldData* Field = FindHerdField(Origin);
+    if (!Field)
+        return false;
+
+    // Well clear of any edge every probe lands on ground, no need to look further
+    const float CliffAvoidanceDistance = Cows[Index]->CliffAvoidanceDistance;
+    float CliffDistance;
+    if (Field->SampleCliffDistance(Origin, CliffDistance) && CliffDistance > CliffAvoidanceDistance + Field->CellSize)
+    {
+        for (bool& bGroundHit : OutGroundHits)
+        {
+            bGroundHit = true;
+        }
+        return true;
+    }
+
+    // Same question the probe trace asks: is there ground inside the probe's vertical span
+    for (int32 Ray = 0; Ray < FCowSensorRays::NumGroundRays; ++Ray)
+    {
+        FVector Start, End;
+        GetGroundRay(Index, Ray, Start, End);
+
+        bool bHasGround;
+        float Height;
+        if (!Field->SampleGround(FVector2D(Start), bHasGround, Height))
+            return false;
+
+        OutGroundHits[Ray] = bHasGround && Height <= Start.Z && Height >= End.Z;
+    }
+
+    return true;
+}
+
+void UCowHerdSubsystem::IssueSensorTraces(int32 Index)
+{
+    UWorld* World = GetWorld();
+    FCowSensorRays& Rays = SensorRays[Index];
+
+    FCollisionQueryParams QueryParams;
+    QueryParams.AddIgnoredActor(Characters[Index]);
+
+    FVector Start, End;
+    {
+        SCOPE_CYCLE_COUNTER(STAT_HerdObstacleSensing);
+        Rays.bObstaclesTraced = ShouldTraceObstacles(Index, Rays.Origin);
+
+        for (int32 Ray = 0; Ray < FCowSensorRays::NumObstacleRays && Rays.bObstaclesTraced; ++Ray)
+        {
+            GetObstacleRay(Index, Ray, Start, End);
+            Rays.ObstacleTraces[Ray] = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, ECC_WorldStatic, QueryParams);
+            ++NumSceneQueries;
+        }
+    }
+
+    {
+        SCOPE_CYCLE_COUNTER(STAT_HerdCliffSensing);
+
+        // Over baked ground the field answers right away and no ground traces are needed
+        Rays.bGroundFromField = SampleGroundField(Index, Rays.FieldGroundHits);
+
+        // Side probes go out every time; waiting on the forward probe first would add another frame
+        for (int32 Ray = 0; Ray < FCowSensorRays::NumGroundRays && !Rays.bGroundFromField; ++Ray)
+        {
+            GetGroundRay(Index, Ray, Start, End);
+            Rays.GroundTraces[Ray] = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End, ECC_WorldStatic, QueryParams);
+            ++NumSceneQueries;
+        }
+    }
+
+    Rays.bPending = true;
+}
+
+bool UCowHerdSubsystem::CollectSensorHits(int32 Index, FCowSensorHits& OutHits) const
+{
+    const FCowSensorRays& Rays = SensorRays[Index];
+    if (!Rays.bPending)
+        return false;
+
+    // Trace data only lives for the frame after it was issued; anything older is gone
+    UWorld* World = GetWorld();
+    FTraceDatum Datum;
+
+    for (int32 Ray = 0; Ray < FCowSensorRays::NumObstacleRays; ++Ray)
+    {
+        if (!Rays.bObstaclesTraced)
+        {
+            OutHits.bObstacleHit[Ray] = false;
+            continue;
+        }
+
+        if (!World->QueryTraceData(Rays.ObstacleTraces[Ray], Datum))
+            return false;
+
+        const FHitResult* Hit = FHitResult::GetFirstBlockingHit(Datum.OutHits);
+        OutHits.bObstacleHit[Ray] = Hit != nullptr;
+        if (Hit)
+        {
+            OutHits.ObstacleDistances[Ray] = Hit->Distance;
+            OutHits.ObstacleNormals[Ray] = Hit->Normal;
+        }
+    }
+
+    for (int32 Ray = 0; Ray < FCowSensorRays::NumGroundRays; ++Ray)
+    {
+        if (Rays.bGroundFromField)
+        {
+            OutHits.bGroundHit[Ray] = Rays.FieldGroundHits[Ray];
+            continue;
+        }
+
+        if (!World->QueryTraceData(Rays.GroundTraces[Ray], Datum))
+            return false;
+
+        OutHits.bGroundHit[Ray] = FHitResult::GetFirstBlockingHit(Datum.OutHits) != nullptr;
+    }
+
+    return true;
+}
+
+void UCowHerdSubsystem::TraceSensorHits(int32 Index, FCowSensorHits& OutHits) const
+{
+    UWorld* World = GetWorld();
+
+    FCollisionQueryParams QueryParams;
+    QueryParams.AddIgnoredActor(Characters[Index]);
+
+    FVector Start, End;
+    FHitResult Hit;
+    {
+        SCOPE_CYCLE_COUNTER(STAT_HerdObstacleSensing);
+        const bool bTraceObstacles = ShouldTraceObstacles(Index, SensorRays[Index].Origin);
+        for (int32 Ray = 0; Ray < FCowSensorRays::NumObstacleRays && bTraceObstacles; ++Ray)
+        {
+            GetObstacleRay(Index, Ray, Start, End);
+            OutHits.bObstacleHit[Ray] = World->LineTraceSingleByChannel(Hit, Start, End, ECC_WorldStatic, QueryParams);
+            ++NumSceneQueries;
+            if (OutHits.bObstacleHit[Ray])
+            {
+                OutHits.ObstacleDistances[Ray] = Hit.Distance;
+                OutHits.ObstacleNormals[Ray] = Hit.Normal;
+            }
+        }
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_HerdCliffSensing);
+    if (SampleGroundField(Index, OutHits.bGroundHit))
+        return;
+
+    for (int32 Ray = 0; Ray < FCowSensorRays::NumGroundRays; ++Ray)
+    {
+        GetGroundRay(Index, Ray, Start, End);
+        OutHits.bGroundHit[Ray] = World->LineTraceSingleByChannel(Hit, Start, End, ECC_WorldStatic, QueryParams);
+        ++NumSceneQueries;
+    }
+}
+
+void UCowHerdSubsystem::ResolveSensors(int32 Index, const FCowSensorHits& Hits)
+{
+    const UCowBoidsComponent& Boids = *Cows[Index];
+    const FCowSensorRays& Rays = SensorRays[Index];
+    const FVector& CurrentVelocity = Velocities[Index];
+
+    SCOPE_CYCLE_COUNTER(STAT_HerdObstacleSensing);
+
+    float ClosestObstacleDistance = Boids.WallAvoidanceDistance;
+    FVector BestAvoidanceDirection = FVector::ZeroVector;
+
+    auto AvoidWall = [&](const FVector& Normal, float Distance)
+    {
+        ClosestObstacleDistance = Distance;
+
+        // Calculate avoidance direction perpendicular to hit normal
+        FVector Right = FVector::CrossProduct(Normal, FVector::UpVector).GetSafeNormal();
+
+        // Choose direction that aligns better with current movement
+        if (FVector::DotProduct(Right, CurrentVelocity) < 0)
+            Right *= -1;
+
+        // Blend between normal and tangent based on distance
+        float NormalInfluence = 1.0f - (Distance / Boids.WallAvoidanceDistance);
+        BestAvoidanceDirection = (Normal * NormalInfluence + Right * (1.0f - NormalInfluence)).GetSafeNormal();
+    };
+
+    // One sample at the current position, so no latency here. Like the feelers,
+    // only react to walls within reach that the cow is heading into.
+    float WallDistance;
+    FVector WallNormal;
+    if (SampleWallField(Positions[Index], WallDistance, WallNormal))
+    {
+        FVector Forward = CurrentVelocity.GetSafeNormal();
+        if (Forward.IsNearlyZero())
+            Forward = Rotations[Index].GetForwardVector();
+
+        if (WallDistance < ClosestObstacleDistance && FVector::DotProduct(Forward, WallNormal) < 0)
+        {
+            AvoidWall(WallNormal, FMath::Max(WallDistance, 0.0f));
+        }
+    }
+
+    // Outside the wall fields only blockers come from the sample, the walls from the feelers
+    if (!HasWallFieldAt(Positions[Index]))
+    {
+        // Results may be a frame old; walls are this much closer along each ray than when it was cast
+        const FVector Travelled = Positions[Index] - Rays.Origin;
+
+        for (int32 Ray = 0; Ray < FCowSensorRays::NumObstacleRays; ++Ray)
+        {
+            if (!Hits.bObstacleHit[Ray])
+                continue;
+
+            FVector Start, End;
+            GetObstacleRay(Index, Ray, Start, End);
+            const FVector Direction = (End - Start).GetSafeNormal();
+
+            float Distance = FMath::Max(Hits.ObstacleDistances[Ray] - FVector::DotProduct(Travelled, Direction), 0.0f);
+            if (Distance < ClosestObstacleDistance)
+            {
+                AvoidWall(Hits.ObstacleNormals[Ray], Distance);
+            }
+        }
+    }
+
+    ObstacleDirections[Index] = BestAvoidanceDirection;
+    ObstacleDistances[Index] = ClosestObstacleDistance;
+
+    // Ground probes only get more conservative as the cow walks toward them, no correction needed
+    FVector AvoidanceDirection = FVector::ZeroVector;
+    if (!Hits.bGroundHit[0])
+    {
+        // Turn away from cliff
+        const FVector Right = FVector::CrossProduct(Rays.Forward, FVector::UpVector);
+
+        // Check which side has ground
+        const bool RightHasGround = Hits.bGroundHit[1];
+        const bool LeftHasGround = Hits.bGroundHit[2];
+
+        if (RightHasGround && !LeftHasGround)
+            AvoidanceDirection = Right;
+        else if (LeftHasGround && !RightHasGround)
+            AvoidanceDirection = -Right;
+        else
+            AvoidanceDirection = -Rays.Forward; // Back away
+
+        AvoidanceDirection.Normalize();
+    }
+
+    CliffDirections[Index] = AvoidanceDirection;
+}
+
+FVector UCowHerdSubsystem::CalculateObstacleAvoidance(int32 Index) const
+{
+    const FVector& BestAvoidanceDirection = ObstacleDirections[Index];
+    if (BestAvoidanceDirection.IsNearlyZero())
+        return FVector::ZeroVector;
+
+    // Stronger avoidance the closer we are
+    float AvoidanceStrength = 1.0f - (ObstacleDistances[Index] / Cows[Index]->WallAvoidanceDistance);
+    FVector AvoidanceForce = BestAvoidanceDirection * MaxSpeeds[Index] * AvoidanceStrength;
+    AvoidanceForce -= Velocities[Index];
+
+    return AvoidanceForce;
+}
+
+FVector UCowHerdSubsystem::CalculateCliffAvoidance(int32 Index) const
+{
+    if (CliffDirections[Index].IsZero())
+        return FVector::ZeroVector;
+
+    return BoidsSteering::Steer(CliffDirections[Index], Velocities[Index], MaxSpeeds[Index]);
+}
+
+FVector UCowHerdSubsystem::CalculatePlayerAttraction(int32 Index) const
+{
+    const FCowHerdInfluenceSample& Attraction = Influences[Index][ECowHerdInfluence::Attraction];
+    if (!Attraction.bInRange)
+        return FVector::ZeroVector;
+
+    // Arrive at the point the map's slope leads to
+    return BoidsSteering::Arrive(Positions[Index], Velocities[Index], Attraction.GetSourceLocation(Positions[Index]), GetAttractionParams(*Cows[Index]));
+}
+
+FVector UCowHerdSubsystem::CalculatePlayerRepulsion(int32 Index) const
+{
+    const FCowHerdInfluenceSample& Repulsion = Influences[Index][ECowHerdInfluence::Repulsion];
+    if (!Repulsion.bInRange)
+        return FVector::ZeroVector;
+
+    // Flee down the slope at repulsion speed, away from every repelling source at once
+    return BoidsSteering::Steer(-Repulsion.Direction, Velocities[Index], Cows[Index]->RepulsionSpeed);
+}
+
+FVector UCowHerdSubsystem::CalculateLaserAttraction(int32 Index) const
+{
+    const FCowHerdInfluenceSample& Lure = Influences[Index][ECowHerdInfluence::Lure];
+    if (!HasState(Index, ECowHerdState::LaserActive) || !Lure.bInRange)
+        return FVector::ZeroVector;
+
+    return BoidsSteering::Arrive(Positions[Index], Velocities[Index], Lure.GetSourceLocation(Positions[Index]), GetLaserParams(*Cows[Index]));
+}
+
+FVector UCowHerdSubsystem::CalculatePenHoming(int32 Index) const
+{
+    FVector2D Direction;
+    float Distance;
+    if (!SampleFlowField(Positions[Index], Direction, Distance) || Distance <= 0.0f)
+        return FVector::ZeroVector;
+
+    FVector Steer = BoidsSteering::Steer(FVector(Direction, 0.0f), Velocities[Index], MaxSpeeds[Index]);
+    Steer.Z = 0; // Keep on ground
+    return Steer;
+}
+
+// ========== Helper Functions ==========
+
+void UCowHerdSubsystem::UpdatePlayerDetection(int32 Index)
+{
+    // Shepherds stamp the herd's largest detection radius, each cow only notices them within its own
+    const FCowHerdInfluence& Influence = Influences[Index];
+    const float DetectionRadius = Cows[Index]->PlayerDetectionRadius;
+    const FCowHerdInfluenceSample& Attraction = Influence[ECowHerdInfluence::Attraction];
+    const FCowHerdInfluenceSample& Repulsion = Influence[ECowHerdInfluence::Repulsion];
+
+    // Repulsion wins when both reach the cow
+    const bool bRepulsed = Repulsion.bInRange && Repulsion.Distance <= DetectionRadius;
+    const bool bAttracted = !bRepulsed && Attraction.bInRange && Attraction.Distance <= DetectionRadius;
+
+    // Mirror onto the cow for Blueprints and animation, only when it changes. A lure in reach shows as attraction
+    // too, as the laser always flagged cows; LaserActive still holds the last sense until UpdateLaserDetection runs.
+    const bool bShowAttracted = !bRepulsed && (bAttracted || Influence[ECowHerdInfluence::Lure].bInRange);
+    const bool bShownAttracted = !HasState(Index, ECowHerdState::Repulsed) && HasState(Index, ECowHerdState::Attracted | ECowHerdState::LaserActive);
+    if (bShowAttracted != bShownAttracted || bRepulsed != HasState(Index, ECowHerdState::Repulsed))
+    {
+        if (bRepulsed)
+        {
+            Characters[Index]->SetPlayerRepulsion(true);
+        }
+        else
+        {
+            Characters[Index]->SetPlayerAttraction(bShowAttracted);
+        }
+    }
+
+    SetState(Index, ECowHerdState::PlayerInRange, bAttracted || bRepulsed);
+    SetState(Index, ECowHerdState::Attracted, bAttracted);
+    SetState(Index, ECowHerdState::Repulsed, bRepulsed);
+}
+
+void UCowHerdSubsystem::UpdateLaserDetection(int32 Index)
+{
+    // Any laser or bait whose lure reaches the cow pulls it, the closest one wins in the map
+    SetState(Index, ECowHerdState::LaserActive, Influences[Index][ECowHerdInfluence::Lure].bInRange);
+}
+
+// ========== Debug ==========
+
+void UCowHerdSubsystem::DrawDebugInfo(int32 Index) const
+{
+    const UCowBoidsComponent& Boids = *Cows[Index];
+    UWorld* World = GetWorld();
+    const FVector Location = Positions[Index];
+    const FVector& CurrentVelocity = Velocities[Index];
+    const bool bIsLaserActive = HasState(Index, ECowHerdState::LaserActive);
+    const bool bAttracted = HasState(Index, ECowHerdState::Attracted);
+
+    // Draw velocity
+    DrawDebugLine(World, Location, Location + CurrentVelocity, FColor::Green, false, -1, 0, 2);
+
+    // Draw perception radius
+    DrawDebugSphere(World, Location, Boids.PerceptionRadius, 16, FColor::Yellow, false, -1, 0, 1);
+
+    // Draw separation radius
+    DrawDebugSphere(World, Location, Boids.SeparationRadius, 12, FColor::Red, false, -1, 0, 1);
+
+    // Draw player detection radius
+    DrawDebugSphere(World, Location, Boids.PlayerDetectionRadius, 20, FColor::Cyan, false, -1, 0, 1);
+
+    // Draw wander circle
+    FVector WanderCenter = Location + Rotations[Index].GetForwardVector() * Boids.WanderDistance;
+    DrawDebugSphere(World, WanderCenter, Boids.WanderRadius, 8, FColor::Blue, false, -1, 0, 1);
+
+    const FCowHerdInfluence& Influence = Influences[Index];
+    const FVector LaserAttractionPoint = Influence[ECowHerdInfluence::Lure].GetSourceLocation(Location);
+    const FVector AttractionPoint = Influence[ECowHerdInfluence::Attraction].GetSourceLocation(Location);
+    const FVector RepulsionPoint = Influence[ECowHerdInfluence::Repulsion].GetSourceLocation(Location);
+
+    // Draw laser attraction if active
+    if (bIsLaserActive)
+    {
+        DrawDebugLine(World, Location, LaserAttractionPoint, FColor::Cyan, false, -1, 0, 3);
+        DrawDebugSphere(World, LaserAttractionPoint, Boids.LaserStopDistance, 12, FColor::Cyan, false, -1, 0, 0.5f);
+        DrawDebugSphere(World, LaserAttractionPoint, Boids.LaserSlowdownDistance, 12, FColor::Blue, false, -1, 0, 0.5f);
+    }
+
+    // Draw attraction stop distance if attracted
+    if (bAttracted && !bIsLaserActive)
+    {
+        DrawDebugSphere(World, AttractionPoint, Boids.AttractionStopDistance, 12, FColor::Green, false, -1, 0, 0.5f);
+        DrawDebugSphere(World, AttractionPoint, Boids.AttractionSlowdownDistance, 12, FColor::Yellow, false, -1, 0, 0.5f);
+    }
+
+    // Draw current speed info
+    FString SpeedInfo = FString::Printf(TEXT("Speed: %.1f / %.1f (Walk: %.1f)"),
+        CurrentVelocity.Size(),
+        MaxSpeeds[Index],
+        Movements[Index]->MaxWalkSpeed);
+    DrawDebugString(World, Location + FVector(0, 0, 100), SpeedInfo, nullptr, FColor::White, 0.0f, true);
+
+    // Draw behavior state
+    FString BehaviorText = TEXT("Neutral");
+    FColor LineColor = FColor::White;
+
+    if (bIsLaserActive)
+    {
+        BehaviorText = TEXT("Laser Attracted");
+        LineColor = FColor::Cyan;
+    }
+    else if (HasState(Index, ECowHerdState::PlayerInRange))
+    {
+        FVector SourcePoint = AttractionPoint;
+        if (bAttracted)
+        {
+            LineColor = FColor::Green;
+            float Distance = Influence[ECowHerdInfluence::Attraction].Distance;
+            if (Distance <= Boids.AttractionStopDistance)
+                BehaviorText = TEXT("Attracted (Stopped)");
+            else if (Distance <= Boids.AttractionSlowdownDistance)
+                BehaviorText = TEXT("Attracted (Slowing)");
+            else
+                BehaviorText = TEXT("Attracted");
+        }
+        else if (HasState(Index, ECowHerdState::Repulsed))
+        {
+            LineColor = FColor::Red;
+            BehaviorText = TEXT("Repulsed");
+            SourcePoint = RepulsionPoint;
+        }
+
+        DrawDebugLine(World, Location, SourcePoint, LineColor, false, -1, 0, 2);
+    }
+
+    DrawDebugString(World, Location + FVector(0, 0, 150), BehaviorText, nullptr, LineColor, 0.0f, true);
+
+    // Show avoidance status
+    const bool bIsAvoidingObstacle = HasState(Index, ECowHerdState::AvoidingObstacle);
+    const bool bIsAvoidingCliff = HasState(Index, ECowHerdState::AvoidingCliff);
+    if (bIsAvoidingObstacle || bIsAvoidingCliff)
+    {
+        FString AvoidanceText = TEXT("");
+        if (bIsAvoidingObstacle) AvoidanceText += TEXT("Avoiding Wall ");
+        if (bIsAvoidingCliff) AvoidanceText += TEXT("Avoiding Cliff");
+        DrawDebugString(World, Location + FVector(0, 0, 200), AvoidanceText, nullptr, FColor::Orange, 0.0f, true);
+    }
+}
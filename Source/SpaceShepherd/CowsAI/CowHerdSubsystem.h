@@ -0,0 +1,436 @@
+// CowHerdSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "CowHerdSpatialGrid.h"
+#include "CowHerdNeighborLists.h"
+#include "CowHerdFlowField.h"
+#include "CowHerdInfluenceMap.h"
+#include "CowHerdSubsystem.generated.h"
+
+class UCowBoidsComponent;
+class ACowCharacter;
+class UCharacterMovementComponent;
+class UPlayerShepherdComponent;
+class UCowHerdFieldData;
+class UCowHerdBlockerComponent;
+class ACowCountingVolume;
+
+// Per-cow behavior state bits, stored packed in the herd state buffer
+enum class ECowHerdState : uint8
+{
+    None             = 0,
+    Enabled          = 1 << 0,
+    PlayerInRange    = 1 << 1,
+    AvoidingObstacle = 1 << 2,
+    AvoidingCliff    = 1 << 3,
+    LaserActive      = 1 << 4,
+    Attracted        = 1 << 5,
+    Repulsed         = 1 << 6,
+    Collidable       = 1 << 7
+};
+ENUM_CLASS_FLAGS(ECowHerdState);
+
+// Simulation detail for a cow, from its significance to the shepherd and the camera
+enum class ECowHerdLOD : uint8
+{
+    Full,       // Steered and sensed every tick
+    Reduced,    // Steered every few ticks on the accumulated time, cliff probes only
+    Frozen      // No steering, sensing or movement ticks until it matters again
+};
+
+// What the herd needs from a shepherd, read once per herd tick
+struct FCowHerdShepherd
+{
+    UPlayerShepherdComponent* Component = nullptr;
+    FVector Location = FVector::ZeroVector;
+    bool bHasLaserTarget = false;
+    FVector LaserAttractionPoint = FVector::ZeroVector;
+};
+
+// Where the last herd tick spent its time, in wall milliseconds per pipeline stage
+struct FCowHerdTickStats
+{
+    double GatherMs = 0.0;
+    double GridMs = 0.0;
+    double ShepherdMs = 0.0;
+    double FlowFieldMs = 0.0;
+    double DetectionMs = 0.0;
+    double LODMs = 0.0;
+    double SensingMs = 0.0;
+    double SteeringMs = 0.0;
+    double ApplyMs = 0.0;
+    double TotalMs = 0.0;
+
+    // Line traces the herd sent to the physics scene, sync and async
+    int32 NumSceneQueries = 0;
+    int32 NumSensed = 0;
+
+    // Cows steered this tick and the separation neighbors they read, over every fixed step
+    int32 NumCowsTicked = 0;
+    int32 NumNeighborsVisited = 0;
+
+    // Cows moved by the herd instead of their character movement
+    int32 NumKinematic = 0;
+
+    // Times the separation neighbor lists were rebuilt this tick, at most once per fixed step
+    int32 NumNeighborListBuilds = 0;
+
+    // Influence map cells written by all sources together
+    int32 NumInfluenceCells = 0;
+};
+
+// Rays cast by one sensing pass of a cow: three wall feelers and three ground probes.
+// The pose they were cast from is kept so results can be corrected when they arrive a frame later.
+struct FCowSensorRays
+{
+    static constexpr int32 NumObstacleRays = 3;
+    static constexpr int32 NumGroundRays = 3;
+
+    FVector Origin = FVector::ZeroVector;
+    FVector Forward = FVector::ForwardVector;
+    FVector Right = FVector::RightVector;
+
+    FTraceHandle ObstacleTraces[NumObstacleRays];
+    FTraceHandle GroundTraces[NumGroundRays];
+    bool bPending = false;
+
+    // Ground answered from a baked field at issue time instead of traces
+    bool bGroundFromField = false;
+    bool FieldGroundHits[NumGroundRays] = {};
+
+    // Wall feelers went out; skipped where the wall field answers at resolve time or the cow's LOD drops them
+    bool bObstaclesTraced = false;
+};
+
+// What a sensing pass found, from async trace data or synchronous traces
+struct FCowSensorHits
+{
+    bool bObstacleHit[FCowSensorRays::NumObstacleRays] = {};
+    float ObstacleDistances[FCowSensorRays::NumObstacleRays] = {};
+    FVector ObstacleNormals[FCowSensorRays::NumObstacleRays];
+    bool bGroundHit[FCowSensorRays::NumGroundRays] = {};
+};
+
+// Actor writes for one cow, collected by the apply pass and flushed together
+struct FCowMovementWrite
+{
+    int32 Index = INDEX_NONE;
+    float MaxWalkSpeed = 0.0f;
+    FVector InputVector = FVector::ZeroVector;
+    FVector Location = FVector::ZeroVector;
+    FQuat Rotation = FQuat::Identity;
+    bool bMove = false;
+    bool bRotate = false;
+};
+
+// Tick function that runs the whole herd once per frame in the same group the boids components used to tick in
+USTRUCT()
+struct FCowHerdTickFunction : public FTickFunction
+{
+    GENERATED_BODY()
+
+    class UCowHerdSubsystem* Target = nullptr;
+
+    virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+    virtual FString DiagnosticMessage() override;
+    virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FCowHerdTickFunction> : public TStructOpsTypeTraitsBase2<FCowHerdTickFunction>
+{
+    enum { WithCopy = false };
+};
+
+/**
+ *  Owns every cow in the world and runs the boids pipeline for all of them in a single tick.
+ *  Per-cow simulation state lives here in structure-of-arrays buffers indexed by the cow's herd index;
+ *  UCowBoidsComponent only registers itself and holds the designer-facing tuning values.
+ */
+UCLASS()
+class UCowHerdSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // ========== Registration ==========
+
+    void RegisterCow(UCowBoidsComponent* Boids);
+    void UnregisterCow(UCowBoidsComponent* Boids);
+    void SetCowEnabled(const UCowBoidsComponent* Boids, bool bEnabled);
+
+    int32 GetNumCows() const { return Cows.Num(); }
+
+    // How many cows got fresh obstacle and cliff queries on the last herd tick (see Herd.SensingBudget)
+    int32 GetNumSensedLastTick() const { return NumSensedLastTick; }
+
+    const FCowHerdTickStats& GetLastTickStats() const { return LastTickStats; }
+
+    ECowHerdLOD GetCowLOD(int32 Index) const { return LODTiers.IsValidIndex(Index) ? LODTiers[Index] : ECowHerdLOD::Full; }
+    bool IsCowKinematic(int32 Index) const { return KinematicMovers.IsValidIndex(Index) && KinematicMovers[Index]; }
+
+    // ========== Shepherds ==========
+
+    void RegisterShepherd(UPlayerShepherdComponent* Shepherd);
+    void UnregisterShepherd(UPlayerShepherdComponent* Shepherd);
+
+    // Closest registered shepherd to Location, nullptr when there is none
+    UPlayerShepherdComponent* FindNearestShepherd(const FVector& Location) const;
+
+    // ========== Fields ==========
+
+    // Baked fields from ACowHerdFieldVolume; sensing samples these instead of tracing where they cover
+    void RegisterHerdField(UCowHerdFieldData* Field);
+    void UnregisterHerdField(UCowHerdFieldData* Field);
+    const UCowHerdFieldData* FindHerdField(const FVector2D& Location) const;
+
+    // Dynamic obstacles layered over the baked wall fields and sampled outside them too
+    void RegisterBlocker(UCowHerdBlockerComponent* Blocker);
+    void UnregisterBlocker(UCowHerdBlockerComponent* Blocker);
+
+    // Distance to the closest baked wall or blocker and the ground-plane direction away from it.
+    // Blockers count everywhere, walls only inside a baked wall field. False when neither is there.
+    bool SampleWallField(const FVector& Location, float& OutDistance, FVector& OutNormal) const;
+
+    // ========== Influence ==========
+
+    // Stamp a source into the next influence map build. Shepherds and their lasers are stamped by the herd;
+    // anything else (bait, trap danger) adds itself each frame it is active, before the herd ticks.
+    void AddInfluenceSource(ECowHerdInfluence Layer, const FVector& Location, float Radius) { InfluenceMap.AddSource(Layer, Location, Radius); }
+
+    // ========== Pens ==========
+
+    // Pens the herd is driven toward; each baked field carries a flow field of walking distances to them
+    void RegisterPen(ACowCountingVolume* Pen);
+    void UnregisterPen(ACowCountingVolume* Pen);
+
+    // The registered pen whose counting bounds contain Location, or null
+    ACowCountingVolume* FindPenContaining(const FVector& Location) const;
+
+    // Ground-plane direction along the flow field toward the closest pen and the walk left.
+    // False outside baked fields, where no pen is reachable, or before the first build completes.
+    bool SampleFlowField(const FVector& Location, FVector2D& OutDirection, float& OutDistance) const;
+
+    // Pen assist makes every cow home toward the pens, not just those with bHomeToPen
+    UFUNCTION(BlueprintCallable, Category = "Herd")
+    void SetPenAssistEnabled(bool bEnabled) { bPenAssist = bEnabled; }
+
+    UFUNCTION(BlueprintPure, Category = "Herd")
+    bool IsPenAssistEnabled() const { return bPenAssist; }
+
+    // ========== Per-Cow Queries ==========
+
+    FVector GetCowVelocity(const UCowBoidsComponent* Boids) const;
+    bool IsCowEnabled(const UCowBoidsComponent* Boids) const;
+
+    // ========== Neighbor Queries ==========
+
+    // Herd indices of collidable cows within Radius, from this frame's grid (rebuilt first if cows left since).
+    // The view is reused by the next query, copy it if it has to outlive that.
+    TArrayView<const int32> QueryCowsInRadius(const FVector& Center, float Radius);
+
+    // Fastest any cow was allowed to move after the last herd tick; how far a cow can be from where the grid has it
+    float GetMaxCowSpeed() const { return MaxCowSpeed; }
+
+    ACowCharacter* GetCowCharacter(int32 Index) const { return Characters.IsValidIndex(Index) ? Characters[Index] : nullptr; }
+    const FCowHerdSpatialGrid& GetSpatialGrid() const { return SpatialGrid; }
+
+    // Runs one herd update; called from the herd tick function.
+    // Under Herd.Deterministic the herd advances in fixed steps: each step senses, steers and moves the kinematic cows
+    // from where the last one left them, and cows draw from seeded streams. Shepherd input is not recorded;
+    // runs are reproducible given the same frame times and the same shepherd movement.
+    void TickHerd(float DeltaTime);
+
+private:
+    // Pipeline stages. Gather, sense and apply run on the game thread;
+    // SimulateCow is pure math over the herd buffers and may run on any worker.
+    void GatherCowState();
+    void BuildSpatialGrid();
+    void UpdateNeighborLists();
+    void UpdateShepherd();
+    void UpdateFlowFields();
+    void SenseCow(int32 Index);
+    void UpdateLOD(float DeltaTime);
+    void UpdateMovers();
+    void UpdateSensors();
+    void SimulateCow(int32 Index, float DeltaTime);
+    void ApplyCowMovement(float DeltaTime, bool bStepped);
+
+    // Fixed-step helpers: refresh neighbors and sensing before every step after the first,
+    // then turn every steered cow and move the kinematic ones along the ground
+    void PrepareFixedStep();
+    void IntegrateCows(float DeltaTime);
+    FQuat TurnTowardVelocity(int32 Index, float DeltaTime) const;
+
+    // Publishes LastTickStats to "stat herd" and the CSV profiler
+    void ReportTickStats() const;
+
+    // Sensing (scene queries). Rays go out as async traces and are read back on the next herd tick;
+    // ResolveSensors turns hits into the sensor buffers, correcting for how far the cow moved meanwhile.
+    // Under a sensing budget only the most urgent cows get new rays, the rest steer on cached results.
+    float GetSensingPriority(int32 Index) const;
+    void PrepareSensorRays(int32 Index);
+    void IssueSensorTraces(int32 Index);
+    bool CollectSensorHits(int32 Index, FCowSensorHits& OutHits) const;
+    void TraceSensorHits(int32 Index, FCowSensorHits& OutHits) const;
+    void ResolveSensors(int32 Index, const FCowSensorHits& Hits);
+    void GetObstacleRay(int32 Index, int32 Ray, FVector& OutStart, FVector& OutEnd) const;
+    void GetGroundRay(int32 Index, int32 Ray, FVector& OutStart, FVector& OutEnd) const;
+    bool SampleGroundField(int32 Index, bool (&OutGroundHits)[FCowSensorRays::NumGroundRays]) const;
+    bool HasWallFieldAt(const FVector& Location) const;
+    bool ShouldTraceObstacles(int32 Index, const FVector& Origin) const;
+
+    // Core boids functions
+    FVector CalculateSteeringForce(int32 Index, float DeltaTime);
+    FVector CalculateSeparation(int32 Index);
+    void CalculateFlocking(int32 Index, FVector& OutAlignment, FVector& OutCohesion) const;
+    FVector CalculateWander(int32 Index, float DeltaTime);
+    FVector CalculateObstacleAvoidance(int32 Index) const;
+    FVector CalculateCliffAvoidance(int32 Index) const;
+    FVector CalculatePlayerAttraction(int32 Index) const;
+    FVector CalculatePlayerRepulsion(int32 Index) const;
+    FVector CalculateLaserAttraction(int32 Index) const;
+    FVector CalculatePenHoming(int32 Index) const;
+
+    // Helper functions
+    void UpdatePlayerDetection(int32 Index);
+    void UpdateLaserDetection(int32 Index);
+    void UpdateMaxSpeed(int32 Index);
+
+    int32 FindNearestShepherdIndex(const FVector& Location) const;
+    void UpdateInfluenceMap();
+
+    bool HasState(int32 Index, ECowHerdState State) const { return EnumHasAnyFlags(States[Index], State); }
+    void SetState(int32 Index, ECowHerdState State, bool bValue);
+    void RemoveCowAt(int32 Index);
+
+    // LOD helpers; significance comes from the engine significance manager
+    void RegisterCowSignificance(int32 Index);
+    float CalculateCowSignificance(const AActor* Cow, const FTransform& Viewpoint) const;
+    ECowHerdLOD SelectLOD(ECowHerdLOD Current, float Distance) const;
+    void SetCowLOD(int32 Index, ECowHerdLOD NewLOD);
+
+    // Kinematic movers: grazing cows away from any shepherd skip character movement and are slid along
+    // the ground by the herd. Anything that needs real movement (pickup, launches, a shepherd closing in)
+    // hands the cow back to its movement component.
+    bool ShouldMoveKinematically(int32 Index) const;
+    void SetCowKinematic(int32 Index, bool bKinematic);
+    bool MoveCowKinematically(int32 Index, float DeltaTime, FVector& OutLocation);
+
+    void DrawDebugInfo(int32 Index) const;
+
+    FCowHerdTickFunction HerdTickFunction;
+
+    // Neighbor lookup over collidable cows, rebuilt each herd tick
+    FCowHerdSpatialGrid SpatialGrid;
+    float GridCellSize = 150.0f;
+    TArray<int32> QueryScratch;
+
+    // Largest PlayerDetectionRadius in the herd, the reach shepherds stamp into the influence map
+    float MaxPlayerDetectionRadius = 0.0f;
+
+    // Largest MaxSpeeds entry written by the last herd tick
+    float MaxCowSpeed = 0.0f;
+
+    // A cow left after the grid was built, so its indices no longer match the herd buffers
+    bool bSpatialGridStale = false;
+
+    // Separation candidates per cow, rebuilt from the grid only when cows have moved far enough (Herd.NeighborSkin)
+    FCowHerdNeighborLists NeighborLists;
+
+    UPROPERTY(Transient)
+    TArray<UCowHerdFieldData*> HerdFields;
+
+    UPROPERTY(Transient)
+    TArray<UCowHerdBlockerComponent*> Blockers;
+
+    // Blocker footprints for this frame: center in XY, radius in W
+    TArray<FVector4> BlockerCircles;
+
+    UPROPERTY(Transient)
+    TArray<ACowCountingVolume*> Pens;
+
+    // One flow field per baked field, same order as HerdFields, and the blockers they were built around.
+    // Dirty fields are rebuilt over several ticks while the previous result keeps steering.
+    TArray<FCowHerdFlowField> FlowFields;
+    TArray<FVector4> FlowFieldBlockers;
+    bool bFlowFieldsDirty = false;
+    bool bPenAssist = false;
+
+    // Attraction, repulsion and lures from every source, rebuilt each herd tick
+    FCowHerdInfluenceMap InfluenceMap;
+
+    // ========== Herd Buffers (one entry per cow, same index everywhere) ==========
+
+    UPROPERTY(Transient)
+    TArray<UCowBoidsComponent*> Cows;
+
+    TArray<ACowCharacter*> Characters;
+    TArray<UCharacterMovementComponent*> Movements;
+
+    // Gathered from the actors at the start of each herd tick; fixed steps advance them in place
+    TArray<FVector> Positions;
+    TArray<FQuat> Rotations;
+
+    // Simulation state persisted across frames
+    TArray<FVector> Velocities;
+    TArray<FVector> WanderTargets;
+    TArray<FRandomStream> RandomStreams;
+    TArray<float> MaxSpeeds;
+    TArray<ECowHerdState> States;
+
+    // Sensor results: avoidance direction (zero when clear) and distance to the closest wall
+    TArray<FVector> ObstacleDirections;
+    TArray<float> ObstacleDistances;
+    TArray<FVector> CliffDirections;
+
+    // Rays in flight for each cow, read back on the following herd tick
+    TArray<FCowSensorRays> SensorRays;
+
+    // Herd ticks since the sensor buffers were last resolved, UnsensedAge when they hold nothing usable
+    TArray<uint16> SensorAges;
+    static constexpr uint16 UnsensedAge = MAX_uint16;
+
+    // Sensing scheduler scratch: (priority, cow index)
+    TArray<TPair<float, int32>> SensingQueue;
+    int32 NumSensedLastTick = 0;
+
+    // Counted by the trace helpers, which are otherwise const queries; game thread only
+    mutable int32 NumSceneQueries = 0;
+    FCowHerdTickStats LastTickStats;
+
+    // LOD tier, time to steer with this tick (zero skips the cow) and time banked by reduced cows
+    TArray<ECowHerdLOD> LODTiers;
+    TArray<float> SteerTimes;
+    TArray<float> PendingSteerTimes;
+    TArray<FTransform> Viewpoints;
+
+    // Cows whose movement component is parked while the herd moves them
+    TArray<bool> KinematicMovers;
+
+    // Apply pass scratch
+    TArray<FCowMovementWrite> MovementWrites;
+    uint32 HerdFrame = 0;
+
+    // Deterministic mode: time not yet stepped, and how many cows have registered (seeds their streams)
+    float StepAccumulator = 0.0f;
+    int32 NumCowsRegistered = 0;
+
+    // Shepherds in the world, maintained by UPlayerShepherdComponent::BeginPlay/EndPlay
+    UPROPERTY(Transient)
+    TArray<UPlayerShepherdComponent*> Shepherds;
+
+    // Shepherd state snapshot for this tick, same order as Shepherds
+    TArray<FCowHerdShepherd> ShepherdStates;
+
+    // Per cow: what the influence map says about its position, sampled when the cow is sensed
+    TArray<FCowHerdInfluence> Influences;
+};
@@ -2,6 +2,8 @@
 #include "PlayerShepherdComponent.h"
 #include "CowCharacter.h"
 #include "CowBoidsComponent.h"
+#include "CowHerdSubsystem.h"
+#include "CowHerdStats.h"
 #include "GameFramework/Actor.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
@@ -9,8 +11,8 @@
 #include "Components/CapsuleComponent.h"
 #include "Components/PrimitiveComponent.h"
 #include "Engine/World.h"
-#include "DrawDebugHelpers.h"
 #include "EngineUtils.h"
+#include "DrawDebugHelpers.h"
 #include "Kismet/GameplayStatics.h"
 #include "Camera/CameraComponent.h"
 
@@ -22,22 +24,70 @@ UPlayerShepherdComponent::UPlayerShepherdComponent()
 void UPlayerShepherdComponent::BeginPlay()
 {
     Super::BeginPlay();
+
+    // Trace the laser from where the character stands this frame, after its movement
+    if (ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner()))
+    {
+        if (UCharacterMovementComponent* MovementComp = OwnerCharacter->GetCharacterMovement())
+        {
+            PrimaryComponentTick.AddPrerequisite(MovementComp, MovementComp->PrimaryComponentTick);
+        }
+    }
+    UpdateAimPrerequisite();
+    UpdatePickupCone();
+    
+    // Let the herd find us without scanning the world
+    HerdSubsystem = GetWorld()->GetSubsystem<UCowHerdSubsystem>();
+    if (HerdSubsystem)
+    {
+        HerdSubsystem->RegisterShepherd(this);
+    }
+}
+
+void UPlayerShepherdComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (AController* Controller = AimController.Get())
+    {
+        PrimaryComponentTick.RemovePrerequisite(Controller, Controller->PrimaryActorTick);
+    }
+    AimController.Reset();
+    
+    if (HerdSubsystem)
+    {
+        HerdSubsystem->UnregisterShepherd(this);
+        HerdSubsystem = nullptr;
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
+#if WITH_EDITOR
+void UPlayerShepherdComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UPlayerShepherdComponent, PickupAngle))
+    {
+        UpdatePickupCone();
+    }
+}
+#endif
+
 void UPlayerShepherdComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+    SCOPE_CYCLE_COUNTER(STAT_HerdShepherdTick);
+    TRACE_CPUPROFILER_EVENT_SCOPE(UPlayerShepherdComponent::TickComponent);
+
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
     
+    // Possession can change at any time, the new controller is waited on from next frame
+    UpdateAimPrerequisite();
+    
     // Update laser attraction if active
     UpdateLaserAttraction();
     
-    // Update nearby cows periodically
-    UpdateTimer += DeltaTime;
-    if (UpdateTimer >= UpdateInterval)
-    {
-        UpdateTimer = 0.0f;
-        UpdateNearbyCows();
-    }
+    // One pickup query per frame, shared by input, the indicator and UI
+    UpdatePickupCandidate();
     
     // Update carried cow position
     if (bIsCarryingCow && CarriedCow)
@@ -57,6 +107,9 @@ void UPlayerShepherdComponent::TickComponent(float DeltaTime, ELevelTick TickTyp
         DrawModeIndicator();
     }
     
+    // Predict the throw while charging; the arc is only swept again when the aim moves
+    UpdateThrowPrediction();
+    
     // Draw throw trajectory
     if (bIsCarryingCow && bIsChargingThrow && bShowThrowTrajectory)
     {
@@ -72,8 +125,7 @@ void UPlayerShepherdComponent::SetShepherdMode(EShepherdMode NewMode)
     {
         CurrentMode = NewMode;
         
-        // Update all nearby cows immediately
-        UpdateNearbyCows();
+        // The herd stamps the new mode into its influence map on its next tick
         
         // Broadcast mode change event
         OnModeChanged.Broadcast(CurrentMode);
@@ -119,11 +171,19 @@ void UPlayerShepherdComponent::TryPickupCow()
         return;
     }
     
+    // Input lands before this frame's tick; a cow that only just walked into the cone is found by asking again
     ACowCharacter* CowToPickup = GetCowInPickupRange();
+    if (!CowToPickup)
+    {
+        UpdatePickupCandidate();
+        CowToPickup = GetCowInPickupRange();
+    }
+    
     if (CowToPickup)
     {
         CarriedCow = CowToPickup;
         bIsCarryingCow = true;
+        PickupCandidate = nullptr;
         
         // Disable cow's physics and AI
         DisableCowPhysics(CarriedCow);
@@ -131,7 +191,7 @@ void UPlayerShepherdComponent::TryPickupCow()
         // Disable the cow's boids behavior
         if (UCowBoidsComponent* BoidsComp = CarriedCow->FindComponentByClass<UCowBoidsComponent>())
         {
-            BoidsComp->SetComponentTickEnabled(false);
+            BoidsComp->SetBoidsEnabled(false);
         }
         
         OnCowPickedUp.Broadcast(CarriedCow);
@@ -149,7 +209,7 @@ void UPlayerShepherdComponent::DropCow()
     // Re-enable the cow's boids behavior
     if (UCowBoidsComponent* BoidsComp = CarriedCow->FindComponentByClass<UCowBoidsComponent>())
     {
-        BoidsComp->SetComponentTickEnabled(true);
+        BoidsComp->SetBoidsEnabled(true);
     }
     
     // Reset carry state
@@ -169,46 +229,76 @@ bool UPlayerShepherdComponent::CanPickupCow() const
 
 ACowCharacter* UPlayerShepherdComponent::GetCowInPickupRange() const
 {
-    if (!GetOwner())
-        return nullptr;
+    // Cached by UpdatePickupCandidate this frame
+    return IsValid(PickupCandidate) ? PickupCandidate : nullptr;
+}
+
+void UPlayerShepherdComponent::SetPickupAngle(float NewPickupAngle)
+{
+    PickupAngle = NewPickupAngle;
+    UpdatePickupCone();
+}
+
+void UPlayerShepherdComponent::UpdatePickupCone()
+{
+    PickupCosAngle = FMath::Cos(FMath::DegreesToRadians(PickupAngle));
+    PickupCosAngleSquared = PickupCosAngle * PickupCosAngle;
+}
+
+void UPlayerShepherdComponent::UpdatePickupCandidate()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UPlayerShepherdComponent::UpdatePickupCandidate);
+
+    PickupCandidate = nullptr;
     
     ACharacter* OwnerCharacter = Cast<ACharacter>(GetOwner());
-    if (!OwnerCharacter)
-        return nullptr;
+    if (!OwnerCharacter || bIsCarryingCow)
+        return;
     
-    FVector PlayerLocation = OwnerCharacter->GetActorLocation();
-    FVector PlayerForward = OwnerCharacter->GetActorForwardVector();
+    const FVector PlayerLocation = OwnerCharacter->GetActorLocation();
+    const FVector PlayerForward = OwnerCharacter->GetActorForwardVector();
     
-    ACowCharacter* ClosestCow = nullptr;
-    float ClosestDistance = PickupRange;
+    // Cone test on squared terms: Dot >= cos(Angle) * Distance, without a square root or acos per cow
+    float ClosestDistanceSquared = FMath::Square(PickupRange);
     
-    // Find all cows in range
-    for (TActorIterator<ACowCharacter> It(GetWorld()); It; ++It)
+    auto ConsiderCow = [&](ACowCharacter* Cow)
     {
-        ACowCharacter* Cow = *It;
-        if (!Cow)
-            continue;
+        if (!IsValid(Cow) || Cow == CarriedCow)
+            return;
         
-        FVector ToCow = Cow->GetActorLocation() - PlayerLocation;
-        float Distance = ToCow.Size();
+        const FVector ToCow = Cow->GetActorLocation() - PlayerLocation;
+        const float DistanceSquared = ToCow.SizeSquared();
+        if (DistanceSquared > ClosestDistanceSquared)
+            return;
         
-        // Check distance
-        if (Distance > PickupRange)
-            continue;
+        const float Dot = FVector::DotProduct(PlayerForward, ToCow);
+        const bool bInCone = PickupCosAngle >= 0.0f
+            ? Dot >= 0.0f && Dot * Dot >= PickupCosAngleSquared * DistanceSquared
+            : Dot >= 0.0f || Dot * Dot <= PickupCosAngleSquared * DistanceSquared;
         
-        // Check angle
-        ToCow.Normalize();
-        float DotProduct = FVector::DotProduct(PlayerForward, ToCow);
-        float Angle = FMath::RadiansToDegrees(FMath::Acos(DotProduct));
-        
-        if (Angle <= PickupAngle && Distance < ClosestDistance)
+        if (bInCone)
         {
-            ClosestCow = Cow;
-            ClosestDistance = Distance;
+            PickupCandidate = Cow;
+            ClosestDistanceSquared = DistanceSquared;
         }
+    };
+    
+    // The herd grid holds where its cows were at the last herd tick; reach as far as one of them can have walked
+    // since, then recheck each at its actual location. Without a herd there is no grid, look at every cow.
+    if (HerdSubsystem)
+    {
+        const float QueryRadius = PickupRange + HerdSubsystem->GetMaxCowSpeed() * GetWorld()->GetDeltaSeconds();
+        for (const int32 HerdIndex : HerdSubsystem->QueryCowsInRadius(PlayerLocation, QueryRadius))
+        {
+            ConsiderCow(HerdSubsystem->GetCowCharacter(HerdIndex));
+        }
+        return;
     }
     
-    return ClosestCow;
+    for (TActorIterator<ACowCharacter> It(GetWorld()); It; ++It)
+    {
+        ConsiderCow(*It);
+    }
 }
 
 // ========== Throwing System ==========
@@ -319,94 +409,6 @@ void UPlayerShepherdComponent::HandleThrowReleased()
 
 // ========== Private Helper Functions ==========
 
-void UPlayerShepherdComponent::UpdateNearbyCows()
-{
-    if (!GetOwner())
-        return;
-    
-    // Clear previous cow states
-    for (ACowCharacter* Cow : NearbyCows)
-    {
-        if (IsValid(Cow) && Cow != CarriedCow)
-        {
-            Cow->SetPlayerAttraction(false);
-            Cow->SetPlayerRepulsion(false);
-        }
-    }
-    
-    NearbyCows.Empty();
-    
-    // Handle laser attraction mode separately - it doesn't depend on player distance
-    if (CurrentMode == EShepherdMode::LaserAttraction && bIsLaserActive && bLaserHasValidHit)
-    {
-        // Find all cows within laser attraction radius
-        for (TActorIterator<ACowCharacter> It(GetWorld()); It; ++It)
-        {
-            ACowCharacter* Cow = *It;
-            if (!Cow || Cow == CarriedCow)
-                continue;
-            
-            // Check if cow has boids component
-            UCowBoidsComponent* BoidsComp = Cow->FindComponentByClass<UCowBoidsComponent>();
-            if (!BoidsComp)
-                continue;
-            
-            // Check distance from laser impact point to cow
-            float DistanceToLaser = FVector::Dist(LaserImpactPoint, Cow->GetActorLocation());
-            if (DistanceToLaser <= LaserAttractionRadius)
-            {
-                NearbyCows.Add(Cow);
-                // Laser attraction uses the standard attraction flag
-                // The boids component will detect it's laser mode through the shepherd component
-                Cow->SetPlayerAttraction(true);
-            }
-        }
-    }
-    else
-    {
-        // Standard proximity-based modes (attraction/repulsion/neutral)
-        for (TActorIterator<ACowCharacter> It(GetWorld()); It; ++It)
-        {
-            ACowCharacter* Cow = *It;
-            if (!Cow || Cow == CarriedCow)
-                continue;
-            
-            // Check if cow has boids component and is within its detection radius
-            UCowBoidsComponent* BoidsComp = Cow->FindComponentByClass<UCowBoidsComponent>();
-            if (BoidsComp)
-            {
-                // For normal modes, check player-to-cow distance
-                float Distance = FVector::Dist(GetOwner()->GetActorLocation(), Cow->GetActorLocation());
-                if (Distance <= BoidsComp->PlayerDetectionRadius)
-                {
-                    NearbyCows.Add(Cow);
-                    
-                    // Set cow state based on current mode
-                    switch (CurrentMode)
-                    {
-                        case EShepherdMode::Attraction:
-                            Cow->SetPlayerAttraction(true);
-                            break;
-                        case EShepherdMode::Repulsion:
-                            Cow->SetPlayerRepulsion(true);
-                            break;
-                        case EShepherdMode::Neutral:
-                        default:
-                            // Already cleared above
-                            break;
-                    }
-                }
-            }
-        }
-    }
-    
-    // Debug logging
-    if (CurrentMode == EShepherdMode::LaserAttraction && bIsLaserActive)
-    {
-        UE_LOG(LogTemp, VeryVerbose, TEXT("Laser Mode: Found %d cows near laser point"), NearbyCows.Num());
-    }
-}
-
 void UPlayerShepherdComponent::UpdateCarriedCow(float DeltaTime)
 {
     if (!CarriedCow || !GetOwner())
@@ -502,8 +504,7 @@ void UPlayerShepherdComponent::DrawModeIndicator()
     // Draw pickup indicator
     if (!bIsCarryingCow)
     {
-        ACowCharacter* CowInRange = GetCowInPickupRange();
-        if (CowInRange)
+        if (ACowCharacter* CowInRange = GetCowInPickupRange())
         {
             // Highlight the cow that can be picked up
             DrawDebugSphere(GetWorld(), CowInRange->GetActorLocation(), 50.0f, 8, FColor::Cyan, false, -1, 0, 2);
@@ -520,35 +521,98 @@ void UPlayerShepherdComponent::DrawModeIndicator()
     }
 }
 
-void UPlayerShepherdComponent::DrawThrowTrajectory()
+void UPlayerShepherdComponent::UpdateThrowPrediction()
 {
-    if (!CarriedCow || !GetOwner())
+    TRACE_CPUPROFILER_EVENT_SCOPE(UPlayerShepherdComponent::UpdateThrowPrediction);
+
+    if (!bIsCarryingCow || !bIsChargingThrow || !CarriedCow || !GetOwner())
+    {
+        ClearThrowPrediction();
         return;
+    }
     
-    FVector StartLocation = CarriedCow->GetActorLocation();
-    FVector InitialVelocity = CalculateThrowVelocity();
+    const FVector StartLocation = CarriedCow->GetActorLocation();
+    const FVector InitialVelocity = CalculateThrowVelocity();
+    const FVector ThrowDirection = InitialVelocity.GetSafeNormal();
     
-    TrajectoryPointsCache.Empty();
+    // Reuse the last sweep while the throw hasn't meaningfully changed
+    if (bThrowPredictionValid
+        && FMath::Abs(CurrentThrowPower - PredictedThrowPower) <= TrajectoryPowerTolerance
+        && FVector::DotProduct(ThrowDirection, PredictedThrowDirection) >= FMath::Cos(FMath::DegreesToRadians(TrajectoryAngleTolerance))
+        && FVector::DistSquared(StartLocation, PredictedThrowStart) <= FMath::Square(TrajectoryPositionTolerance))
+        return;
+    
+    PredictedThrowStart = StartLocation;
+    PredictedThrowDirection = ThrowDirection;
+    PredictedThrowPower = CurrentThrowPower;
+    bThrowPredictionValid = true;
+    
+    // The cow's own gravity, so scaled or redirected gravity and physics volumes match the real flight
+    const UCharacterMovementComponent* MovementComp = CarriedCow->GetCharacterMovement();
+    const FVector Gravity = MovementComp
+        ? -MovementComp->GetGravityDirection() * MovementComp->GetGravityZ()
+        : FVector(0.0f, 0.0f, GetWorld()->GetGravityZ());
+    
+    // Sweep the cow's capsule with its own collision responses; collision is off while carried but the responses stay
+    const UCapsuleComponent* Capsule = CarriedCow->GetCapsuleComponent();
+    const FCollisionShape Shape = Capsule ? Capsule->GetCollisionShape() : FCollisionShape::MakeSphere(50.0f);
+    const ECollisionChannel Channel = Capsule ? Capsule->GetCollisionObjectType() : ECC_Pawn;
+    const FCollisionResponseParams ResponseParams = Capsule ? FCollisionResponseParams(Capsule->GetCollisionResponseToChannels()) : FCollisionResponseParams::DefaultResponseParam;
+    const FQuat Rotation = CarriedCow->GetActorQuat();
     
-    // Simulate trajectory
-    for (int32 i = 0; i < TrajectoryPoints; i++)
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ShepherdThrowPrediction), false, GetOwner());
+    QueryParams.AddIgnoredActor(CarriedCow);
+    
+    TrajectoryPointsCache.Reset();
+    TrajectoryPointsCache.Add(StartLocation);
+    bHasPredictedLanding = false;
+    bPredictedLandingInPen = false;
+    
+    for (int32 i = 1; i < TrajectoryPoints; i++)
     {
-        float Time = i * TrajectoryTimeStep;
+        const float Time = i * TrajectoryTimeStep;
+        const FVector Point = StartLocation + InitialVelocity * Time + 0.5f * Gravity * Time * Time;
         
-        // Physics equation: s = ut + 0.5at^2
-        FVector Point = StartLocation + InitialVelocity * Time;
-        Point.Z += 0.5f * GetWorld()->GetGravityZ() * Time * Time;
-        
-        TrajectoryPointsCache.Add(Point);
-        
-        // Draw point
-        DrawDebugSphere(GetWorld(), Point, 5.0f, 4, FColor::Yellow, false, -1, 0, 1);
-        
-        // Draw line between points
-        if (i > 0)
+        // The first thing the cow would touch ends the arc
+        FHitResult Hit;
+        if (GetWorld()->SweepSingleByChannel(Hit, TrajectoryPointsCache.Last(), Point, Rotation, Channel, Shape, QueryParams, ResponseParams))
         {
-            DrawDebugLine(GetWorld(), TrajectoryPointsCache[i-1], Point, FColor::Yellow, false, -1, 0, 2);
+            TrajectoryPointsCache.Add(Hit.Location);
+            bHasPredictedLanding = true;
+            PredictedLandingPoint = Hit.Location;
+            bPredictedLandingInPen = HerdSubsystem && HerdSubsystem->FindPenContaining(Hit.Location);
+            break;
         }
+        
+        TrajectoryPointsCache.Add(Point);
+    }
+}
+
+void UPlayerShepherdComponent::ClearThrowPrediction()
+{
+    if (!bThrowPredictionValid)
+        return;
+    
+    TrajectoryPointsCache.Reset();
+    bThrowPredictionValid = false;
+    bHasPredictedLanding = false;
+    bPredictedLandingInPen = false;
+}
+
+void UPlayerShepherdComponent::DrawThrowTrajectory()
+{
+    if (TrajectoryPointsCache.Num() < 2)
+        return;
+    
+    for (int32 i = 1; i < TrajectoryPointsCache.Num(); i++)
+    {
+        DrawDebugLine(GetWorld(), TrajectoryPointsCache[i-1], TrajectoryPointsCache[i], FColor::Yellow, false, -1, 0, 2);
+    }
+    
+    // Green when the cow would land in a pen
+    if (bHasPredictedLanding)
+    {
+        DrawDebugSphere(GetWorld(), PredictedLandingPoint, 40.0f, 8, bPredictedLandingInPen ? FColor::Green : FColor::Yellow, false, -1, 0, 2);
     }
 }
 
@@ -579,7 +643,7 @@ void UPlayerShepherdComponent::ThrowCow()
         FTimerHandle EnableBoidsTimer;
         GetWorld()->GetTimerManager().SetTimer(EnableBoidsTimer, [BoidsComp]()
         {
-            BoidsComp->SetComponentTickEnabled(true);
+            BoidsComp->SetBoidsEnabled(true);
         }, 2.0f, false);
     }
     
@@ -728,6 +792,8 @@ void UPlayerShepherdComponent::UpdateLaserAttraction()
 
 void UPlayerShepherdComponent::PerformLaserTrace()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(UPlayerShepherdComponent::PerformLaserTrace);
+
     if (!GetOwner())
         return;
     
@@ -796,6 +862,11 @@ FVector UPlayerShepherdComponent::GetLaserDirection() const
     // Get the camera direction for third person aiming
     if (APlayerController* PC = Cast<APlayerController>(OwnerCharacter->GetController()))
     {
+        // The camera manager caches its view after all ticks, so it is a frame behind the mouse here.
+        // The control rotation already has this frame's input and is what the camera will look along.
+        if (bLateLatchLaserAim)
+            return PC->GetControlRotation().Vector();
+        
         // Get camera location and rotation
         FVector CameraLocation;
         FRotator CameraRotation;
@@ -809,6 +880,26 @@ FVector UPlayerShepherdComponent::GetLaserDirection() const
     return OwnerCharacter->GetActorForwardVector();
 }
 
+void UPlayerShepherdComponent::UpdateAimPrerequisite()
+{
+    const APawn* OwnerPawn = Cast<APawn>(GetOwner());
+    AController* Controller = OwnerPawn ? OwnerPawn->GetController() : nullptr;
+    if (Controller == AimController.Get())
+        return;
+    
+    if (AController* OldController = AimController.Get())
+    {
+        PrimaryComponentTick.RemovePrerequisite(OldController, OldController->PrimaryActorTick);
+    }
+    
+    // The controller tick processes input and updates the control rotation the laser aims with
+    if (Controller)
+    {
+        PrimaryComponentTick.AddPrerequisite(Controller, Controller->PrimaryActorTick);
+    }
+    AimController = Controller;
+}
+
 void UPlayerShepherdComponent::DrawLaser()
 {
     if (!bIsLaserActive || !GetOwner())
@@ -29,6 +29,10 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 
 public:
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
@@ -82,6 +86,10 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Shepherd|Laser")
     float LaserAttractionStrength = 2.0f;
     
+    // Aim with this frame's control rotation instead of the camera view, which only updates after every tick
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Shepherd|Laser")
+    bool bLateLatchLaserAim = true;
+    
     // Laser state
     UPROPERTY(BlueprintReadOnly, Category = "Shepherd|Laser")
     bool bIsLaserActive = false;
@@ -98,9 +106,13 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Shepherd|Carrying")
     float PickupRange = 200.0f;
     
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Shepherd|Carrying")
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetPickupAngle, Category = "Shepherd|Carrying")
     float PickupAngle = 45.0f; // Cone angle in degrees
     
+    // Closest cow in the pickup cone, refreshed once per tick while not carrying; UI should read this instead of querying
+    UPROPERTY(BlueprintReadOnly, Category = "Shepherd|Carrying")
+    class ACowCharacter* PickupCandidate = nullptr;
+    
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Shepherd|Carrying")
     FVector CarryOffset = FVector(150.0f, 0.0f, 100.0f); // Offset from player
     
@@ -135,6 +147,26 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Shepherd|Throwing")
     float TrajectoryTimeStep = 0.1f;
     
+    // The arc is only swept again when power, aim (degrees) or start position move past these
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Shepherd|Throwing")
+    float TrajectoryPowerTolerance = 0.02f;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Shepherd|Throwing")
+    float TrajectoryAngleTolerance = 0.5f;
+    
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Shepherd|Throwing")
+    float TrajectoryPositionTolerance = 5.0f;
+    
+    // Predicted throw while charging: where the cow's capsule first hits something, and whether that is inside a pen
+    UPROPERTY(BlueprintReadOnly, Category = "Shepherd|Throwing")
+    bool bHasPredictedLanding = false;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "Shepherd|Throwing")
+    FVector PredictedLandingPoint = FVector::ZeroVector;
+    
+    UPROPERTY(BlueprintReadOnly, Category = "Shepherd|Throwing")
+    bool bPredictedLandingInPen = false;
+    
     // Current carrying state
     UPROPERTY(BlueprintReadOnly, Category = "Shepherd|Carrying")
     class ACowCharacter* CarriedCow = nullptr;
@@ -212,6 +244,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Shepherd|Carrying")
     class ACowCharacter* GetCowInPickupRange() const;
     
+    UFUNCTION(BlueprintCallable, Category = "Shepherd|Carrying")
+    void SetPickupAngle(float NewPickupAngle);
+    
     // ========== Throwing Functions ==========
     
     UFUNCTION(BlueprintCallable, Category = "Shepherd|Throwing")
@@ -253,10 +288,13 @@ public:
     void HandleLaserReleased();
 
 private:
-    void UpdateNearbyCows();
+    void UpdatePickupCandidate();
+    void UpdatePickupCone();
     void DrawModeIndicator();
     void UpdateCarriedCow(float DeltaTime);
     void UpdateThrowCharge(float DeltaTime);
+    void UpdateThrowPrediction();
+    void ClearThrowPrediction();
     void DrawThrowTrajectory();
     void ThrowCow();
     FVector GetCarryPosition() const;
@@ -269,17 +307,25 @@ private:
     void DrawLaser();
     FVector GetLaserStartPosition() const;
     FVector GetLaserDirection() const;
+    void UpdateAimPrerequisite();
     
-    // Cache of nearby cows for efficient updates
     UPROPERTY()
-    TArray<class ACowCharacter*> NearbyCows;
+    class UCowHerdSubsystem* HerdSubsystem = nullptr;
     
-    float UpdateTimer = 0.0f;
-    const float UpdateInterval = 0.2f; // Update nearby cows every 0.2 seconds
+    // Cosine of PickupAngle and its square, refreshed whenever the angle changes
+    float PickupCosAngle = 0.0f;
+    float PickupCosAngleSquared = 0.0f;
     
-    // Trajectory preview points
+    // Trajectory preview points, up to the first hit, and the throw they were swept for
     TArray<FVector> TrajectoryPointsCache;
+    FVector PredictedThrowStart = FVector::ZeroVector;
+    FVector PredictedThrowDirection = FVector::ZeroVector;
+    float PredictedThrowPower = 0.0f;
+    bool bThrowPredictionValid = false;
     
     // Laser trace hit result
     FHitResult LaserHitResult;
+    
+    // Controller our tick waits on, so the laser sees its input from this frame
+    TWeakObjectPtr<AController> AimController;
 };
\ No newline at end of file
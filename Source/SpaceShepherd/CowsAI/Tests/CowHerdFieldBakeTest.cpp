@@ -0,0 +1,96 @@
+// CowHerdFieldBakeTest.cpp
+#include "CowsAI/CowHerdFieldBake.h"
+#include "CowsAI/CowHerdFieldData.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+namespace
+{
+    constexpr EAutomationTestFlags FieldBakeTestFlags = EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter;
+
+    // A flat floor at height 0, 12 x 5 points, 1 m apart
+    UCowHerdFieldData* MakeFloorField(TArray<FCowHerdFieldColumn>& OutColumns)
+    {
+        UCowHerdFieldData* Field = NewObject<UCowHerdFieldData>();
+        Field->CellSize = 100.0f;
+        Field->SizeX = 12;
+        Field->SizeY = 5;
+
+        FCowHerdFieldColumn Floor;
+        Floor.TopHeight = 0.0f;
+        Floor.bTopWalkable = true;
+        OutColumns.Init(Floor, Field->SizeX * Field->SizeY);
+        return Field;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCowHerdFieldBakeBoxWallTest, "SpaceShepherd.Herd.FieldBake.BoxWall", FieldBakeTestFlags)
+
+bool FCowHerdFieldBakeBoxWallTest::RunTest(const FString& Parameters)
+{
+    // A 2 m tall box wall two points thick across the floor: the traces hit its flat top first, then the floor under it
+    TArray<FCowHerdFieldColumn> Columns;
+    UCowHerdFieldData* Field = MakeFloorField(Columns);
+    for (int32 Y = 0; Y < Field->SizeY; ++Y)
+    {
+        for (const int32 X : { 5, 6 })
+        {
+            FCowHerdFieldColumn& Column = Columns[Field->GetCellIndex(X, Y)];
+            Column.TopHeight = 200.0f;
+            Column.BelowHeight = 0.0f;
+        }
+    }
+
+    TArray<bool> Obstacles;
+    CowHerdFieldBake::BakeGround(*Field, Columns, 45.0f, Obstacles);
+    CowHerdFieldBake::BakeCliffDistances(*Field, 150.0f);
+    CowHerdFieldBake::BakeWallDistances(*Field, Obstacles);
+
+    for (int32 X = 0; X < Field->SizeX; ++X)
+    {
+        const int32 Cell = Field->GetCellIndex(X, 2);
+        const bool bInWall = X == 5 || X == 6;
+
+        TestEqual(FString::Printf(TEXT("Point %d: obstacle"), X), Obstacles[Cell], bInWall);
+        TestEqual(FString::Printf(TEXT("Point %d: ground is the floor"), X), Field->GroundHeights[Cell], 0.0f);
+        TestTrue(FString::Printf(TEXT("Point %d: no cliff at the wall (%d)"), X, Field->CliffDistances[Cell]), Field->CliffDistances[Cell] == TNumericLimits<uint16>::Max());
+
+        if (bInWall)
+        {
+            TestTrue(FString::Printf(TEXT("Point %d: inside the wall (%d)"), X, Field->WallDistances[Cell]), Field->WallDistances[Cell] < 0);
+        }
+        else
+        {
+            TestTrue(FString::Printf(TEXT("Point %d: outside the wall (%d)"), X, Field->WallDistances[Cell]), Field->WallDistances[Cell] > 0);
+        }
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCowHerdFieldBakeSteepFaceTest, "SpaceShepherd.Herd.FieldBake.SteepFace", FieldBakeTestFlags)
+
+bool FCowHerdFieldBakeSteepFaceTest::RunTest(const FString& Parameters)
+{
+    // A point landing on a steep face with nothing walkable under it is a wall, not ground and not a hole
+    TArray<FCowHerdFieldColumn> Columns;
+    UCowHerdFieldData* Field = MakeFloorField(Columns);
+    FCowHerdFieldColumn& Face = Columns[Field->GetCellIndex(5, 2)];
+    Face.TopHeight = 80.0f;
+    Face.bTopWalkable = false;
+
+    TArray<bool> Obstacles;
+    CowHerdFieldBake::BakeGround(*Field, Columns, 45.0f, Obstacles);
+    CowHerdFieldBake::BakeWallDistances(*Field, Obstacles);
+
+    const int32 Cell = Field->GetCellIndex(5, 2);
+    TestTrue(TEXT("Steep face is an obstacle"), Obstacles[Cell]);
+    TestEqual(TEXT("Steep face keeps its height"), Field->GroundHeights[Cell], 80.0f);
+    TestTrue(TEXT("Steep face bakes inside a wall"), Field->WallDistances[Cell] < 0);
+    TestTrue(TEXT("Floor beside it is outside"), Field->WallDistances[Field->GetCellIndex(3, 2)] > 0);
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
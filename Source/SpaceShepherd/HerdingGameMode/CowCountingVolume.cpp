@@ -1,6 +1,8 @@
 // CowCountingVolume.cpp
 #include "CowCountingVolume.h"
 #include "CowHerdingGameMode.h"
+#include "CowsAI/CowHerdSubsystem.h"
+#include "CowsAI/CowHerdMass.h"
 #include "Components/BoxComponent.h"
 #include "Engine/World.h"
 #include "DrawDebugHelpers.h"
@@ -32,6 +34,12 @@ void ACowCountingVolume::BeginPlay()
 {
     Super::BeginPlay();
     
+    // The herd steers toward pens whether or not this game mode is counting them
+    if (UCowHerdSubsystem* HerdSubsystem = GetWorld()->GetSubsystem<UCowHerdSubsystem>())
+    {
+        HerdSubsystem->RegisterPen(this);
+    }
+    
     // Get reference to game mode
     GameModeRef = Cast<ACowHerdingGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
     
@@ -54,10 +62,26 @@ void ACowCountingVolume::BeginPlay()
         if (IsValidCow(Actor))
         {
             GameModeRef->RegisterCowInVolume(Actor);
+            CowHerdMass::SetEntityPenned(Actor, true);
         }
     }
 }
 
+void ACowCountingVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UCowHerdSubsystem* HerdSubsystem = GetWorld()->GetSubsystem<UCowHerdSubsystem>())
+    {
+        HerdSubsystem->UnregisterPen(this);
+    }
+    
+    Super::EndPlay(EndPlayReason);
+}
+
+FBox ACowCountingVolume::GetPenBounds() const
+{
+    return DetectionVolume->Bounds.GetBox();
+}
+
 void ACowCountingVolume::OnConstruction(const FTransform& Transform)
 {
     Super::OnConstruction(Transform);
@@ -85,6 +109,7 @@ void ACowCountingVolume::OnVolumeBeginOverlap(UPrimitiveComponent* OverlappedCom
     if (IsValidCow(OtherActor))
     {
         GameModeRef->RegisterCowInVolume(OtherActor);
+        CowHerdMass::SetEntityPenned(OtherActor, true);
         
         if (bShowDebugInfo)
         {
@@ -105,7 +130,16 @@ void ACowCountingVolume::OnVolumeEndOverlap(UPrimitiveComponent* OverlappedCompo
     
     if (IsValidCow(OtherActor))
     {
-        GameModeRef->UnregisterCowFromVolume(OtherActor);
+        // An actor the Mass representation takes away ends its overlaps too; its entity stays in the pen and counted
+        if (CowHerdMass::IsRepresentationDespawn(OtherActor))
+        {
+            GameModeRef->HoldDespawnedCowInVolume(OtherActor);
+        }
+        else
+        {
+            GameModeRef->UnregisterCowFromVolume(OtherActor);
+            CowHerdMass::SetEntityPenned(OtherActor, false);
+        }
         
         if (bShowDebugInfo)
         {
@@ -29,8 +29,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Debug")
 	FColor VolumeColor = FColor::Green;
     
+	// World bounds of the counting area, the target of the herd's pen flow field
+	FBox GetPenBounds() const;
+    
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void OnConstruction(const FTransform& Transform) override;
     
 	UFUNCTION()
@@ -1,6 +1,7 @@
 // CowHerdingGameMode.cpp
 #include "CowHerdingGameMode.h"
 #include "CowHerdingHUD.h"
+#include "CowsAI/CowHerdMass.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
 #include "Kismet/GameplayStatics.h"
@@ -49,6 +50,7 @@ void ACowHerdingGameMode::StartGame()
     RemainingTime = GameDuration;
     CurrentCowsInVolume = 0;
     CowsInVolume.Empty();
+    HeldCowEntities.Empty();
     
     // Broadcast initial state
     OnTimeUpdated.Broadcast(RemainingTime);
@@ -107,8 +109,23 @@ void ACowHerdingGameMode::RegisterCowInVolume(AActor* Cow)
     if (!CowsInVolume.Contains(Cow))
     {
         CowsInVolume.Add(Cow);
-        CurrentCowsInVolume = CowsInVolume.Num();
-        OnCowCountChanged.Broadcast(CurrentCowsInVolume);
+        
+        // A held cow whose actor came back is the same cow; the representation links a fresh actor to its
+        // entity only after spawning it, so look again next tick if the link isn't there yet
+        if (HeldCowEntities.Num() > 0)
+        {
+            const uint64 EntityKey = CowHerdMass::GetEntityKey(Cow);
+            if (EntityKey != 0)
+            {
+                HeldCowEntities.Remove(EntityKey);
+            }
+            else
+            {
+                GetWorldTimerManager().SetTimerForNextTick(this, &ACowHerdingGameMode::ReconcileHeldCows);
+            }
+        }
+        
+        UpdateCowCount();
         
         UE_LOG(LogTemp, Log, TEXT("Cow entered volume. Total: %d"), CurrentCowsInVolume);
     }
@@ -124,13 +141,52 @@ void ACowHerdingGameMode::UnregisterCowFromVolume(AActor* Cow)
     // Remove cow if it was in the set
     if (CowsInVolume.Remove(Cow) > 0)
     {
-        CurrentCowsInVolume = CowsInVolume.Num();
-        OnCowCountChanged.Broadcast(CurrentCowsInVolume);
+        UpdateCowCount();
         
         UE_LOG(LogTemp, Log, TEXT("Cow left volume. Total: %d"), CurrentCowsInVolume);
     }
 }
 
+void ACowHerdingGameMode::HoldDespawnedCowInVolume(AActor* Cow)
+{
+    if (!bGameActive || !Cow)
+    {
+        return;
+    }
+    
+    // The cow is still in the pen as a Mass entity, it keeps counting under that
+    const uint64 EntityKey = CowHerdMass::GetEntityKey(Cow);
+    if (CowsInVolume.Remove(Cow) > 0 && EntityKey != 0)
+    {
+        HeldCowEntities.Add(EntityKey);
+    }
+    
+    UpdateCowCount();
+}
+
+void ACowHerdingGameMode::ReconcileHeldCows()
+{
+    for (AActor* Cow : CowsInVolume)
+    {
+        if (const uint64 EntityKey = IsValid(Cow) ? CowHerdMass::GetEntityKey(Cow) : 0)
+        {
+            HeldCowEntities.Remove(EntityKey);
+        }
+    }
+    
+    UpdateCowCount();
+}
+
+void ACowHerdingGameMode::UpdateCowCount()
+{
+    const int32 NewCount = CowsInVolume.Num() + HeldCowEntities.Num();
+    if (NewCount != CurrentCowsInVolume)
+    {
+        CurrentCowsInVolume = NewCount;
+        OnCowCountChanged.Broadcast(CurrentCowsInVolume);
+    }
+}
+
 void ACowHerdingGameMode::UpdateTimer()
 {
     if (!bGameActive)
@@ -61,6 +61,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Cow Management")
     void UnregisterCowFromVolume(AActor* Cow);
     
+    // Keeps counting a penned cow whose actor the Mass representation took away, until an actor for it comes back
+    void HoldDespawnedCowInVolume(AActor* Cow);
+    
     UFUNCTION(BlueprintCallable, Category = "Cow Management")
     int32 GetCurrentCowCount() const { return CurrentCowsInVolume; }
     
@@ -79,6 +82,13 @@ private:
     UPROPERTY()
     TSet<AActor*> CowsInVolume;
     
+    // Penned cows that only live as Mass entities right now, by entity key
+    TSet<uint64> HeldCowEntities;
+    
     // Update the timer
     void UpdateTimer();
+    
+    // Drops held entities whose cow is back in CowsInVolume as an actor
+    void ReconcileHeldCows();
+    void UpdateCowCount();
 };
\ No newline at end of file
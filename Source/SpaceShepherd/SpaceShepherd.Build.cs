@@ -18,7 +18,15 @@ public class SpaceShepherd : ModuleRules
 			"StateTreeModule",
 			"GameplayStateTreeModule",
 			"UMG",
-			"Niagara"
+			"Niagara",
+			"SignificanceManager",
+			"HerdBoids",
+			"MassEntity",
+			"MassCommon",
+			"MassActors",
+			"MassSpawner",
+			"MassLOD",
+			"MassRepresentation"
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[] { });
@@ -17,6 +17,7 @@
 #include "Camera/CameraShakeBase.h"
 #include "CowsAI/CowBoidsComponent.h"
 #include "CowsAI/CowCharacter.h"
+#include "CowsAI/CowHerdStats.h"
 #include "Engine/OverlapResult.h"
 
 ALandmineTrap::ALandmineTrap()
@@ -71,6 +72,9 @@ void ALandmineTrap::BeginPlay()
 
 void ALandmineTrap::Tick(float DeltaTime)
 {
+    SCOPE_CYCLE_COUNTER(STAT_HerdTrapTick);
+    TRACE_CPUPROFILER_EVENT_SCOPE(ALandmineTrap::Tick);
+
     Super::Tick(DeltaTime);
     
     // Update arming indicators
@@ -181,6 +185,8 @@ void ALandmineTrap::Explode()
 
 void ALandmineTrap::ApplyExplosionForces()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(ALandmineTrap::ApplyExplosionForces);
+
     FVector ExplosionLocation = GetActorLocation();
     
     // Find all actors in explosion radius
@@ -243,7 +249,7 @@ void ALandmineTrap::LaunchCow(ACowCharacter* Cow)
     // Disable boids temporarily
     if (UCowBoidsComponent* BoidsComp = Cow->FindComponentByClass<UCowBoidsComponent>())
     {
-        BoidsComp->SetComponentTickEnabled(false);
+        BoidsComp->SetBoidsEnabled(false);
         
         // Re-enable after a delay
         FTimerHandle ReenableTimer;
@@ -251,7 +257,7 @@ void ALandmineTrap::LaunchCow(ACowCharacter* Cow)
         {
             if (IsValid(BoidsComp))
             {
-                BoidsComp->SetComponentTickEnabled(true);
+                BoidsComp->SetBoidsEnabled(true);
             }
         }, 3.0f, false);
     }
@@ -1,6 +1,8 @@
 // SpikeTrap.cpp
 #include "SpikeTrap.h"
 #include "CowsAI/CowCharacter.h"
+#include "CowsAI/CowHerdStats.h"
+#include "CowsAI/CowHerdMass.h"
 #include "Components/BoxComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Kismet/GameplayStatics.h"
@@ -57,6 +59,9 @@ void ASpikeTrap::BeginPlay()
 
 void ASpikeTrap::Tick(float DeltaTime)
 {
+    SCOPE_CYCLE_COUNTER(STAT_HerdTrapTick);
+    TRACE_CPUPROFILER_EVENT_SCOPE(ASpikeTrap::Tick);
+
     Super::Tick(DeltaTime);
     
     // Update spike position if moving
@@ -194,6 +199,8 @@ void ASpikeTrap::RetractSpikes()
 
 void ASpikeTrap::KillCowsOnSpikes()
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(ASpikeTrap::KillCowsOnSpikes);
+
     TArray<ACowCharacter*> CowsToKill = GetCowsInTrigger();
     
     for (ACowCharacter* Cow : CowsToKill)
@@ -226,7 +233,8 @@ void ASpikeTrap::KillCowsOnSpikes()
         // Broadcast kill event
         OnCowKilled.Broadcast(this, Cow);
         
-        // Destroy the cow
+        // Destroy the cow, and the Mass entity behind it so the representation does not respawn it
+        CowHerdMass::DestroyEntityForActor(Cow);
         Cow->Destroy();
         
         UE_LOG(LogTemp, Warning, TEXT("SpikeTrap killed cow: %s"), *Cow->GetName());